@@ -1,5 +1,7 @@
-#ifndef EASYARGS_H
+#if !defined(SUBCOMMANDS) && (!defined(EASYARGS_H) || defined(EASYARGS_PREFIX))
+#ifndef EASYARGS_PREFIX
 #define EASYARGS_H
+#endif
 
 /*
     EasyArgs: A simple, single-header argument parser for C
@@ -12,211 +14,694 @@
 */
 
 #include <stdio.h>
-#include <stdlib.h>  // used for parsing (atoi, atof)
-#include <string.h>  // used for strcmp
+#include <stdlib.h>  // used for parsing (strtof, strtod)
+#include <string.h>  // used for strlen, memcmp
 #include <limits.h>  // used for type limits
 #include <errno.h>   // used for errno
 #include <stdint.h>  // used for SIZE_MAX
-#include <ctype.h>   // used for isspace
+#include <stddef.h>  // used for offsetof
+#include <float.h>   // used for FLT_EVAL_METHOD
+#include <stdarg.h>  // used for building help text
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>  // used for write
+#include <fcntl.h>     // used for mapping response files
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef EASYARGS_THREADS
+#include <pthread.h>  // used for splitting large response files
+#endif
+
+
+// SCHEMA PREFIX
+// Define EASYARGS_PREFIX before including to put that prefix in front of every name generated
+// from the schema, e.g. tool_args_t, tool_parse_args and tool_EASYARGS_OPT_verbose for prefix
+// tool. The header can then be included again after redefining REQUIRED_ARGS, OPTIONAL_ARGS,
+// BOOLEAN_ARGS and EASYARGS_PREFIX, so one program can parse several schemas. Names that do not
+// depend on the schema, like easyargs_errors_t, easyargs_parse_int and the response file
+// functions, are shared. Options like EASYARGS_HASH_DISPATCH apply to every schema included
+// after them.
+#define EASYARGS_PREFIXED(prefix, name) EASYARGS_PREFIXED_I(prefix, name)
+#define EASYARGS_PREFIXED_I(prefix, name) prefix##_##name
+
+#undef EASYARGS_NAME
+#ifdef EASYARGS_PREFIX
+#define EASYARGS_NAME(name) EASYARGS_PREFIXED(EASYARGS_PREFIX, name)
+
+// Generated names, renamed until the end of this header
+#define REQUIRED_ARG_COUNT EASYARGS_NAME(REQUIRED_ARG_COUNT)
+#define OPTIONAL_ARG_COUNT EASYARGS_NAME(OPTIONAL_ARG_COUNT)
+#define BOOLEAN_ARG_COUNT EASYARGS_NAME(BOOLEAN_ARG_COUNT)
+#define EASYARGS_BOOLEAN_COUNT EASYARGS_NAME(EASYARGS_BOOLEAN_COUNT)
+#define EASYARGS_BOOLEAN_WORDS EASYARGS_NAME(EASYARGS_BOOLEAN_WORDS)
+#define args_t EASYARGS_NAME(args_t)
+#define EASYARGS_ARGS_SIZE EASYARGS_NAME(EASYARGS_ARGS_SIZE)
+#define EASYARGS_ARGS_PADDING EASYARGS_NAME(EASYARGS_ARGS_PADDING)
+#define easyargs_args_size_check EASYARGS_NAME(easyargs_args_size_check)
+#define make_default_args EASYARGS_NAME(make_default_args)
+#define EASYARGS_OPTION_COUNT EASYARGS_NAME(EASYARGS_OPTION_COUNT)
+#define easyargs_token_t EASYARGS_NAME(easyargs_token_t)
+#define easyargs_load_token EASYARGS_NAME(easyargs_load_token)
+#define easyargs_token_equals EASYARGS_NAME(easyargs_token_equals)
+#define easyargs_option_flags EASYARGS_NAME(easyargs_option_flags)
+#define easyargs_option_flag_lengths EASYARGS_NAME(easyargs_option_flag_lengths)
+#define easyargs_options EASYARGS_NAME(easyargs_options)
+#define easyargs_dispatch_t EASYARGS_NAME(easyargs_dispatch_t)
+#define EASYARGS_HASH_SLOTS EASYARGS_NAME(EASYARGS_HASH_SLOTS)
+#define easyargs_hash EASYARGS_NAME(easyargs_hash)
+#define easyargs_insert_option EASYARGS_NAME(easyargs_insert_option)
+#define easyargs_build_dispatch EASYARGS_NAME(easyargs_build_dispatch)
+#define easyargs_find_option EASYARGS_NAME(easyargs_find_option)
+#define easyargs_filter_t EASYARGS_NAME(easyargs_filter_t)
+#define EASYARGS_FILTER_WORDS EASYARGS_NAME(EASYARGS_FILTER_WORDS)
+#define easyargs_filter_hash EASYARGS_NAME(easyargs_filter_hash)
+#define easyargs_filter_add EASYARGS_NAME(easyargs_filter_add)
+#define easyargs_filter_test EASYARGS_NAME(easyargs_filter_test)
+#define easyargs_build_filter EASYARGS_NAME(easyargs_build_filter)
+#define easyargs_tokens_t EASYARGS_NAME(easyargs_tokens_t)
+#define easyargs_token_shape EASYARGS_NAME(easyargs_token_shape)
+#define easyargs_store_token EASYARGS_NAME(easyargs_store_token)
+#define easyargs_count_bytes EASYARGS_NAME(easyargs_count_bytes)
+#define easyargs_classify_contiguous EASYARGS_NAME(easyargs_classify_contiguous)
+#define easyargs_classify EASYARGS_NAME(easyargs_classify)
+#define easyargs_bundle_t EASYARGS_NAME(easyargs_bundle_t)
+#define easyargs_build_bundle EASYARGS_NAME(easyargs_build_bundle)
+#define easyargs_apply_bundle EASYARGS_NAME(easyargs_apply_bundle)
+#define easyargs_required_labels EASYARGS_NAME(easyargs_required_labels)
+#define easyargs_error_format EASYARGS_NAME(easyargs_error_format)
+#define easyargs_format_error EASYARGS_NAME(easyargs_format_error)
+#define easyargs_print_errors EASYARGS_NAME(easyargs_print_errors)
+#define easyargs_context_t EASYARGS_NAME(easyargs_context_t)
+#define easyargs_init_context EASYARGS_NAME(easyargs_init_context)
+#define easyargs_parse EASYARGS_NAME(easyargs_parse)
+#define parse_args EASYARGS_NAME(parse_args)
+#define parse_args_quiet EASYARGS_NAME(parse_args_quiet)
+#define parse_args_with_context EASYARGS_NAME(parse_args_with_context)
+#define easyargs_is_repeatable_option EASYARGS_NAME(easyargs_is_repeatable_option)
+#define easyargs_alloc_lists EASYARGS_NAME(easyargs_alloc_lists)
+#define free_args EASYARGS_NAME(free_args)
+#define EASYARGS_REQUIRED_COUNT EASYARGS_NAME(EASYARGS_REQUIRED_COUNT)
+#define easyargs_stream_t EASYARGS_NAME(easyargs_stream_t)
+#define easyargs_store_required EASYARGS_NAME(easyargs_store_required)
+#define easyargs_store_value EASYARGS_NAME(easyargs_store_value)
+#define easyargs_store_boolean EASYARGS_NAME(easyargs_store_boolean)
+#define easyargs_start_stream EASYARGS_NAME(easyargs_start_stream)
+#define easyargs_free_stream EASYARGS_NAME(easyargs_free_stream)
+#define easyargs_flush_stream EASYARGS_NAME(easyargs_flush_stream)
+#define easyargs_stream_error EASYARGS_NAME(easyargs_stream_error)
+#define easyargs_stream_copy EASYARGS_NAME(easyargs_stream_copy)
+#define easyargs_stream_token EASYARGS_NAME(easyargs_stream_token)
+#define easyargs_feed EASYARGS_NAME(easyargs_feed)
+#define easyargs_finish EASYARGS_NAME(easyargs_finish)
+#define easyargs_parse_fd EASYARGS_NAME(easyargs_parse_fd)
+#define EASYARGS_HELP_WIDTH EASYARGS_NAME(EASYARGS_HELP_WIDTH)
+#define EASYARGS_HELP_SIZE EASYARGS_NAME(EASYARGS_HELP_SIZE)
+#define easyargs_format_help EASYARGS_NAME(easyargs_format_help)
+#define easyargs_help_text EASYARGS_NAME(easyargs_help_text)
+#define easyargs_emit_help EASYARGS_NAME(easyargs_emit_help)
+#define easyargs_write_help EASYARGS_NAME(easyargs_write_help)
+#define print_help EASYARGS_NAME(print_help)
+#else
+#define EASYARGS_NAME(name) name
+#endif
 
 
+// The typed macros pass an alignment class to EASYARGS_OPTIMIZE_LAYOUT (see ARG_T STRUCT):
+// W for 8-byte types, P for pointer- or long-sized types, I for int-sized types, B for bytes
+#define EASYARGS_TYPED_REQUIRED(class, ...) REQUIRED_ARG(__VA_ARGS__)
+#define EASYARGS_TYPED_OPTIONAL(class, ...) OPTIONAL_ARG(__VA_ARGS__)
+
+// List options (see below) pass their item type, list type and item parser. Code that treats
+// them like any other option sees an OPTIONAL_ARG of the list type, defaulting to empty.
+#define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+#define EASYARGS_LIST_AS_OPTIONAL(item, list, name, flag, label, description, parser) \
+    EASYARGS_TYPED_OPTIONAL(P, list, name, { 0 }, flag, label, description, "", parser)
+
+// Likewise array options, whose type is generated for each (see ARG_T STRUCT)
+#define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+#define EASYARGS_ARRAY_AS_OPTIONAL(item, capacity, name, flag, label, description, parser) \
+    EASYARGS_TYPED_OPTIONAL(U, EASYARGS_NAME(easyargs_array_##name), name, { { 0 } }, flag, label, description, "", parser)
+
+// And vector options, which pass their element type, vector type and vector parser
+#define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+#define EASYARGS_VECTOR_AS_OPTIONAL(item, vector, name, flag, label, description, parser) \
+    EASYARGS_TYPED_OPTIONAL(P, vector, name, { 0 }, flag, label, description, "", parser)
+
 // REQUIRED_ARG(type, name, label, description, parser)
 // label and description should be strings, e.g. "contrast" and "Contrast applied to image"
-#define REQUIRED_STRING_ARG(name, label, description) REQUIRED_ARG(char*, name, label, description, easyargs_parse_str)
-#define REQUIRED_CHAR_ARG(name, label, description) REQUIRED_ARG(char, name, label, description, easyargs_parse_char)
-#define REQUIRED_INT_ARG(name, label, description) REQUIRED_ARG(int, name, label, description, easyargs_parse_int)
-#define REQUIRED_UINT_ARG(name, label, description) REQUIRED_ARG(unsigned int, name, label, description, easyargs_parse_uint)
-#define REQUIRED_LONG_ARG(name, label, description) REQUIRED_ARG(long, name, label, description, easyargs_parse_long)
-#define REQUIRED_ULONG_ARG(name, label, description) REQUIRED_ARG(unsigned long, name, label, description, easyargs_parse_ulong)
-#define REQUIRED_LONG_LONG_ARG(name, label, description) REQUIRED_ARG(long long, name, label, description, easyargs_parse_llong)
-#define REQUIRED_ULONG_LONG_ARG(name, label, description) REQUIRED_ARG(unsigned long long, name, label, description, easyargs_parse_ullong)
-#define REQUIRED_SIZE_ARG(name, label, description) REQUIRED_ARG(size_t, name, label, description, easyargs_parse_size_t)
-#define REQUIRED_FLOAT_ARG(name, label, description) REQUIRED_ARG(float, name, label, description, easyargs_parse_float)
-#define REQUIRED_DOUBLE_ARG(name, label, description) REQUIRED_ARG(double, name, label, description, easyargs_parse_double)
+#define REQUIRED_STRING_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(P, char*, name, label, description, easyargs_parse_str)
+#define REQUIRED_CHAR_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(B, char, name, label, description, easyargs_parse_char)
+#define REQUIRED_INT_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(I, int, name, label, description, easyargs_parse_int)
+#define REQUIRED_UINT_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(I, unsigned int, name, label, description, easyargs_parse_uint)
+#define REQUIRED_LONG_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(P, long, name, label, description, easyargs_parse_long)
+#define REQUIRED_ULONG_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(P, unsigned long, name, label, description, easyargs_parse_ulong)
+#define REQUIRED_LONG_LONG_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(W, long long, name, label, description, easyargs_parse_llong)
+#define REQUIRED_ULONG_LONG_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(W, unsigned long long, name, label, description, easyargs_parse_ullong)
+#define REQUIRED_SIZE_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(P, size_t, name, label, description, easyargs_parse_size_t)
+#define REQUIRED_FLOAT_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(I, float, name, label, description, easyargs_parse_float)
+#define REQUIRED_DOUBLE_ARG(name, label, description) EASYARGS_TYPED_REQUIRED(W, double, name, label, description, easyargs_parse_double)
 
 // OPTIONAL_ARG(type, name, default, flag, label, description, formatter, parser)
-#define OPTIONAL_STRING_ARG(name, default, flag, label, description) OPTIONAL_ARG(char*, name, default, flag, label, description, "%s", easyargs_parse_str)
-#define OPTIONAL_CHAR_ARG(name, default, flag, label, description) OPTIONAL_ARG(char, name, default, flag, label, description, "%c", easyargs_parse_char)
-#define OPTIONAL_INT_ARG(name, default, flag, label, description) OPTIONAL_ARG(int, name, default, flag, label, description, "%d", easyargs_parse_int)
-#define OPTIONAL_UINT_ARG(name, default, flag, label, description) OPTIONAL_ARG(unsigned int, name, default, flag, label, description, "%u", easyargs_parse_uint)
-#define OPTIONAL_LONG_ARG(name, default, flag, label, description) OPTIONAL_ARG(long, name, default, flag, label, description, "%ld", easyargs_parse_long)
-#define OPTIONAL_ULONG_ARG(name, default, flag, label, description) OPTIONAL_ARG(unsigned long, name, default, flag, label, description, "%lu", easyargs_parse_ulong)
-#define OPTIONAL_LONG_LONG_ARG(name, default, flag, label, description) OPTIONAL_ARG(long long, name, default, flag, label, description, "%lld", easyargs_parse_llong)
-#define OPTIONAL_ULONG_LONG_ARG(name, default, flag, label, description) OPTIONAL_ARG(unsigned long long, name, default, flag, label, description, "%llu", easyargs_parse_ullong)
-#define OPTIONAL_SIZE_ARG(name, default, flag, label, description) OPTIONAL_ARG(size_t, name, default, flag, label, description, "%zu", easyargs_parse_size_t)
-#define OPTIONAL_FLOAT_ARG(name, default, flag, label, description, precision) OPTIONAL_ARG(float, name, default, flag, label, description, "%." #precision "g", easyargs_parse_float)
-#define OPTIONAL_DOUBLE_ARG(name, default, flag, label, description, precision) OPTIONAL_ARG(double, name, default, flag, label, description, "%." #precision "g", easyargs_parse_double)
+#define OPTIONAL_STRING_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(P, char*, name, default, flag, label, description, "%s", easyargs_parse_str)
+#define OPTIONAL_CHAR_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(B, char, name, default, flag, label, description, "%c", easyargs_parse_char)
+#define OPTIONAL_INT_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(I, int, name, default, flag, label, description, "%d", easyargs_parse_int)
+#define OPTIONAL_UINT_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(I, unsigned int, name, default, flag, label, description, "%u", easyargs_parse_uint)
+#define OPTIONAL_LONG_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(P, long, name, default, flag, label, description, "%ld", easyargs_parse_long)
+#define OPTIONAL_ULONG_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(P, unsigned long, name, default, flag, label, description, "%lu", easyargs_parse_ulong)
+#define OPTIONAL_LONG_LONG_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(W, long long, name, default, flag, label, description, "%lld", easyargs_parse_llong)
+#define OPTIONAL_ULONG_LONG_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(W, unsigned long long, name, default, flag, label, description, "%llu", easyargs_parse_ullong)
+#define OPTIONAL_SIZE_ARG(name, default, flag, label, description) EASYARGS_TYPED_OPTIONAL(P, size_t, name, default, flag, label, description, "%zu", easyargs_parse_size_t)
+#define OPTIONAL_FLOAT_ARG(name, default, flag, label, description, precision) EASYARGS_TYPED_OPTIONAL(I, float, name, default, flag, label, description, "%." #precision "g", easyargs_parse_float)
+#define OPTIONAL_DOUBLE_ARG(name, default, flag, label, description, precision) EASYARGS_TYPED_OPTIONAL(W, double, name, default, flag, label, description, "%." #precision "g", easyargs_parse_double)
+
+// OPTIONAL_*_LIST_ARG(name, flag, label, description) may be repeated, e.g. -I src -I include.
+// Its values are kept in order in args.name.items[0] to args.name.items[args.name.count - 1].
+// All lists of one parse share a single allocation, released by free_args.
+#define OPTIONAL_STRING_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(char*, easyargs_string_list_t, name, flag, label, description, easyargs_parse_str)
+#define OPTIONAL_CHAR_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(char, easyargs_char_list_t, name, flag, label, description, easyargs_parse_char)
+#define OPTIONAL_INT_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(int, easyargs_int_list_t, name, flag, label, description, easyargs_parse_int)
+#define OPTIONAL_UINT_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(unsigned int, easyargs_uint_list_t, name, flag, label, description, easyargs_parse_uint)
+#define OPTIONAL_LONG_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(long, easyargs_long_list_t, name, flag, label, description, easyargs_parse_long)
+#define OPTIONAL_ULONG_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(unsigned long, easyargs_ulong_list_t, name, flag, label, description, easyargs_parse_ulong)
+#define OPTIONAL_LONG_LONG_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(long long, easyargs_llong_list_t, name, flag, label, description, easyargs_parse_llong)
+#define OPTIONAL_ULONG_LONG_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(unsigned long long, easyargs_ullong_list_t, name, flag, label, description, easyargs_parse_ullong)
+#define OPTIONAL_SIZE_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(size_t, easyargs_size_list_t, name, flag, label, description, easyargs_parse_size_t)
+#define OPTIONAL_FLOAT_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(float, easyargs_float_list_t, name, flag, label, description, easyargs_parse_float)
+#define OPTIONAL_DOUBLE_LIST_ARG(name, flag, label, description) EASYARGS_TYPED_LIST(double, easyargs_double_list_t, name, flag, label, description, easyargs_parse_double)
+
+// OPTIONAL_*_ARRAY_ARG(name, capacity, flag, label, description) may also be repeated, but
+// keeps up to capacity values inside args_t itself, as args.name.items and args.name.count,
+// so parsing it never allocates. More values than that is an error.
+#define OPTIONAL_STRING_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(char*, capacity, name, flag, label, description, easyargs_parse_str)
+#define OPTIONAL_CHAR_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(char, capacity, name, flag, label, description, easyargs_parse_char)
+#define OPTIONAL_INT_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(int, capacity, name, flag, label, description, easyargs_parse_int)
+#define OPTIONAL_UINT_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(unsigned int, capacity, name, flag, label, description, easyargs_parse_uint)
+#define OPTIONAL_LONG_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(long, capacity, name, flag, label, description, easyargs_parse_long)
+#define OPTIONAL_ULONG_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(unsigned long, capacity, name, flag, label, description, easyargs_parse_ulong)
+#define OPTIONAL_LONG_LONG_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(long long, capacity, name, flag, label, description, easyargs_parse_llong)
+#define OPTIONAL_ULONG_LONG_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(unsigned long long, capacity, name, flag, label, description, easyargs_parse_ullong)
+#define OPTIONAL_SIZE_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(size_t, capacity, name, flag, label, description, easyargs_parse_size_t)
+#define OPTIONAL_FLOAT_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(float, capacity, name, flag, label, description, easyargs_parse_float)
+#define OPTIONAL_DOUBLE_ARRAY_ARG(name, capacity, flag, label, description) EASYARGS_TYPED_ARRAY(double, capacity, name, flag, label, description, easyargs_parse_double)
+
+// OPTIONAL_*_VECTOR_ARG(name, flag, label, description) takes comma-separated numbers, e.g.
+// --weights 0.1,0.25,0.5, and may be repeated to append more. Its values are kept like a
+// list's, in args.name.items and args.name.count, but items is aligned to
+// EASYARGS_VECTOR_ALIGNMENT (64) bytes, so it can be handed to SIMD loops as is.
+#define OPTIONAL_FLOAT_VECTOR_ARG(name, flag, label, description) EASYARGS_TYPED_VECTOR(float, easyargs_float_vector_t, name, flag, label, description, easyargs_parse_float_vector)
+#define OPTIONAL_DOUBLE_VECTOR_ARG(name, flag, label, description) EASYARGS_TYPED_VECTOR(double, easyargs_double_vector_t, name, flag, label, description, easyargs_parse_double_vector)
+#define OPTIONAL_INT64_VECTOR_ARG(name, flag, label, description) EASYARGS_TYPED_VECTOR(int64_t, easyargs_int64_vector_t, name, flag, label, description, easyargs_parse_int64_vector)
 
 // BOOLEAN_ARG(name, flag, description)
 
+// HOT(entry) marks any of the above as frequently read, e.g. HOT(OPTIONAL_UINT_ARG(threads, ...)).
+// It only changes the layout of args_t, with EASYARGS_OPTIMIZE_LAYOUT.
+#define HOT(entry) entry
+
+#ifndef EASYARGS_COMMON_H
+
 // HELPER FUNCTIONS
+// Whitespace as isspace sees it in the C locale, whatever the current locale
+static inline int easyargs_is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
 static inline const char* easyargs_skip_leading(const char *s) {
     if (!s) return s;
-    while (isspace((unsigned char)*s)) ++s;
+    while (easyargs_is_space(*s)) ++s;
     return s;
 }
 
-// PARSERS
-static inline char* easyargs_parse_str(const char* text, int* ok) {
-    *ok = 0;
+// Text appended to a fixed buffer, snprintf style: length keeps counting past size
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t length;
+} easyargs_text_t;
+
+static inline void easyargs_appendf(easyargs_text_t* text, const char* format, ...) {
+    size_t room = text->length < text->size ? text->size - text->length : 0;
+    va_list list;
+    va_start(list, format);
+    int written = vsnprintf(room ? text->buffer + text->length : NULL, room, format, list);
+    va_end(list);
+    if (written > 0)
+        text->length += (size_t) written;
+}
 
-    if (!text) {
-        fprintf(stderr, "Error: null string value.\n");
-        return NULL;
+// Load 8 bytes as a little-endian integer; compilers turn this into a single load
+static inline uint64_t easyargs_load_le64(const char* text) {
+    const unsigned char* bytes = (const unsigned char*) text;
+    return (uint64_t) bytes[0] | (uint64_t) bytes[1] << 8 | (uint64_t) bytes[2] << 16 | (uint64_t) bytes[3] << 24 |
+           (uint64_t) bytes[4] << 32 | (uint64_t) bytes[5] << 40 | (uint64_t) bytes[6] << 48 | (uint64_t) bytes[7] << 56;
+}
+
+// Whether all 8 bytes are ASCII digits
+static inline int easyargs_is_eight_digits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0u) | (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u;
+}
+
+// Convert 8 ASCII digits (first digit in the lowest byte) to their value, combining pairs in parallel
+static inline uint32_t easyargs_parse_eight_digits(uint64_t chunk) {
+    const uint64_t mask = 0x000000FF000000FFu;
+    const uint64_t mul1 = 0x000F424000000064u; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001u; // 1 + (10000 << 32)
+    chunk -= 0x3030303030303030u;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+    return (uint32_t) chunk;
+}
+
+static inline int easyargs_hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Scan an integer with the syntax strtoull/strtoll accept with base 0: an optional sign, then
+// decimal, 0x-prefixed hex or 0-prefixed octal digits, and nothing after them.
+// Returns 0 if text is not such a number. Otherwise stores the magnitude and sign, and sets
+// *overflow if the magnitude does not fit in an unsigned long long.
+// Decimal digits are consumed 8 at a time.
+static inline int easyargs_scan_integer(const char* text, unsigned long long* magnitude, int* negative, int* overflow) {
+    unsigned long long value = 0;
+    *negative = 0;
+    *overflow = 0;
+
+    if (*text == '+' || *text == '-') {
+        *negative = *text == '-';
+        text++;
     }
 
-    if (text[0] == '\0') {
-        fprintf(stderr, "Error: empty string value not allowed.\n");
-        return NULL;
+    if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        // Without a hex digit after it, the x is not part of the number
+        if (easyargs_hex_digit(text[2]) < 0)
+            return 0;
+        for (text += 2; *text; text++) {
+            int digit = easyargs_hex_digit(*text);
+            if (digit < 0)
+                return 0;
+            if (value > ULLONG_MAX >> 4)
+                *overflow = 1;
+            else
+                value = value << 4 | (unsigned long long) digit;
+        }
+    } else if (text[0] == '0') {
+        for (text++; *text; text++) {
+            if (*text < '0' || *text > '7')
+                return 0;
+            if (value > ULLONG_MAX >> 3)
+                *overflow = 1;
+            else
+                value = value << 3 | (unsigned long long) (*text - '0');
+        }
+    } else {
+        size_t len = strlen(text);
+        if (len == 0)
+            return 0;
+
+        while (len >= 8) {
+            uint64_t chunk = easyargs_load_le64(text);
+            if (!easyargs_is_eight_digits(chunk))
+                break;
+            uint32_t eight = easyargs_parse_eight_digits(chunk);
+            if (value > (ULLONG_MAX - eight) / 100000000u)
+                *overflow = 1;
+            else
+                value = value * 100000000u + eight;
+            text += 8;
+            len -= 8;
+        }
+
+        for (; len; text++, len--) {
+            if (*text < '0' || *text > '9')
+                return 0;
+            unsigned digit = (unsigned) (*text - '0');
+            if (value > (ULLONG_MAX - digit) / 10)
+                *overflow = 1;
+            else
+                value = value * 10 + digit;
+        }
     }
 
-    *ok = 1;
-    return (char*) text;
+    *magnitude = value;
+    return 1;
 }
 
-static inline char easyargs_parse_char(const char* text, int* ok) {
-    *ok = 0;
+// Scan a plain decimal number: an optional sign, digits with an optional '.', and an optional
+// exponent. Returns 0 for any other form, or for more than 19 significant digits; otherwise
+// text equals (-1)^negative * mantissa * 10^exponent exactly.
+static inline int easyargs_scan_decimal(const char* text, uint64_t* mantissa, int* exponent, int* negative) {
+    uint64_t digits = 0;
+    int count = 0;
+    int scale = 0;
+    int seen_digit = 0;
+    int seen_point = 0;
+
+    *negative = 0;
+    if (*text == '+' || *text == '-') {
+        *negative = *text == '-';
+        text++;
+    }
 
-    if (!text) {
-        fprintf(stderr, "Error: null input for character argument.\n");
-        return 0;
+    for (;; text++) {
+        if (*text >= '0' && *text <= '9') {
+            seen_digit = 1;
+            if (digits == 0 && *text == '0') {
+                // Leading zeros are not significant
+            } else if (count < 19) {
+                digits = digits * 10 + (uint64_t) (*text - '0');
+                count++;
+            } else {
+                return 0;
+            }
+            if (seen_point)
+                scale--;
+        } else if (*text == '.' && !seen_point) {
+            seen_point = 1;
+        } else {
+            break;
+        }
     }
-    if (text[0] == '\0' || text[1] != '\0') {
-        fprintf(stderr, "Error: '%s' is not a valid character.\n", text);
+    if (!seen_digit)
         return 0;
+
+    if (*text == 'e' || *text == 'E') {
+        int exponent_negative = 0;
+        int value = 0;
+        text++;
+        if (*text == '+' || *text == '-') {
+            exponent_negative = *text == '-';
+            text++;
+        }
+        if (*text < '0' || *text > '9')
+            return 0;
+        for (; *text >= '0' && *text <= '9'; text++) {
+            if (value > 9999)
+                return 0;
+            value = value * 10 + (*text - '0');
+        }
+        scale += exponent_negative ? -value : value;
     }
 
-    *ok = 1;
-    return text[0];
+    if (*text != '\0')
+        return 0;
+
+    *mantissa = digits;
+    *exponent = scale;
+    return 1;
 }
 
-#define DEFINE_UNSIGNED_INTEGER_PARSER(funcname, rettype, maxval, typename) \
-static inline rettype funcname(const char* text, int* ok) { \
-    *ok = 0; \
-    if (!text) { \
-        fprintf(stderr, "Error: null input for %s.\n", typename); \
-        return 0; \
-    } \
+// Correctly rounded conversion for the common case, without strtod (Clinger's fast path): when
+// the digits and the power of ten are both exactly representable, one multiply or divide rounds
+// correctly. Returns 0 if text is not such a number. Needs arithmetic in the declared precision.
+static inline int easyargs_fast_double(const char* text, double* value) {
+    #if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    uint64_t mantissa;
+    int exponent, negative;
+    if (!easyargs_scan_decimal(text, &mantissa, &exponent, &negative))
+        return 0;
+    if (mantissa > ((uint64_t) 1 << 53) || (mantissa && (exponent < -22 || exponent > 22)))
+        return 0;
+
+    double result = (double) mantissa;
+    if (mantissa)
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+    *value = negative ? -result : result;
+    return 1;
+    #else
+    (void) text;
+    (void) value;
+    return 0;
+    #endif
+}
+
+static inline int easyargs_fast_float(const char* text, float* value) {
+    #if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static const float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    uint64_t mantissa;
+    int exponent, negative;
+    if (!easyargs_scan_decimal(text, &mantissa, &exponent, &negative))
+        return 0;
+    if (mantissa > ((uint64_t) 1 << 24) || (mantissa && (exponent < -10 || exponent > 10)))
+        return 0;
+
+    float result = (float) mantissa;
+    if (mantissa)
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+    *value = negative ? -result : result;
+    return 1;
+    #else
+    (void) text;
+    (void) value;
+    return 0;
+    #endif
+}
+
+// SCANNERS
+// Reentrant core of the parsers: each returns a status and stores the value only on success.
+// They use no global state and do no I/O, and apart from the strtod/strtof fallback for floats
+// outside the fast path (see easyargs_fast_double), do not depend on the locale.
+typedef enum {
+    EASYARGS_OK,
+    EASYARGS_ERR_NULL,      // text is NULL
+    EASYARGS_ERR_EMPTY,     // text is empty (after leading whitespace, for numbers)
+    EASYARGS_ERR_NEGATIVE,  // negative value for an unsigned type
+    EASYARGS_ERR_SYNTAX,    // text is not a value of the type
+    EASYARGS_ERR_RANGE,     // value does not fit the type
+
+    // Only reported by parse_args_quiet
+    EASYARGS_ERR_INVALID,       // value rejected by a custom parser
+    EASYARGS_ERR_MISSING_ARGS,  // fewer arguments than required arguments
+    EASYARGS_ERR_MISSING_VALUE, // option given as the last argument
+    EASYARGS_ERR_UNKNOWN_OPTION, // argument matches no flag, and was ignored
+    EASYARGS_ERR_UNKNOWN_COMMAND, // first argument names no subcommand
+
+    // Only reported when streaming arguments
+    EASYARGS_ERR_READ,      // reading failed, or out of memory
+    EASYARGS_ERR_TOO_LONG,  // argument longer than the stream buffer
+
+    EASYARGS_ERR_NO_MEMORY, // no room for the values of list options
+    EASYARGS_ERR_TOO_MANY   // more values than an array option holds
+} easyargs_status_t;
+
+static inline easyargs_status_t easyargs_scan_str(const char* text, char** value) {
+    if (!text) return EASYARGS_ERR_NULL;
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY;
+    *value = (char*) text;
+    return EASYARGS_OK;
+}
+
+static inline easyargs_status_t easyargs_scan_char(const char* text, char* value) {
+    if (!text) return EASYARGS_ERR_NULL;
+    if (text[0] == '\0' || text[1] != '\0') return EASYARGS_ERR_SYNTAX;
+    *value = text[0];
+    return EASYARGS_OK;
+}
+
+#define DEFINE_UNSIGNED_INTEGER_SCANNER(funcname, valtype, maxval) \
+static inline easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
     text = easyargs_skip_leading(text); \
-    if (text[0] == '\0') { \
-        fprintf(stderr, "Error: empty input for %s.\n", typename); \
-        return 0; \
-    } \
-    if (text[0] == '-') { \
-        fprintf(stderr, "Error: '%s' negative value not allowed for %s.\n", text, typename); \
-        return 0; \
-    } \
-    char* end; \
-    errno = 0; \
-    unsigned long long val = strtoull(text, &end, 0); \
-    if (*end != '\0') { \
-        fprintf(stderr, "Error: '%s' is not a valid %s.\n", text, typename); \
-        return 0; \
-    } \
-    if (errno == ERANGE || val > (unsigned long long)(maxval)) { \
-        fprintf(stderr, "Error: '%s' is out of range for %s.\n", text, typename); \
-        return 0; \
-    } \
-    *ok = 1; \
-    return (rettype) val; \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    if (text[0] == '-') return EASYARGS_ERR_NEGATIVE; \
+    unsigned long long val; \
+    int negative, overflow; \
+    if (!easyargs_scan_integer(text, &val, &negative, &overflow)) return EASYARGS_ERR_SYNTAX; \
+    if (overflow || val > (unsigned long long)(maxval)) return EASYARGS_ERR_RANGE; \
+    *value = (valtype) val; \
+    return EASYARGS_OK; \
 }
 
-DEFINE_UNSIGNED_INTEGER_PARSER(easyargs_parse_uint, unsigned int, UINT_MAX, "unsigned int")
-DEFINE_UNSIGNED_INTEGER_PARSER(easyargs_parse_ulong, unsigned long, ULONG_MAX, "unsigned long")
-DEFINE_UNSIGNED_INTEGER_PARSER(easyargs_parse_ullong, unsigned long long, ULLONG_MAX, "unsigned long long")
-DEFINE_UNSIGNED_INTEGER_PARSER(easyargs_parse_size_t, size_t, SIZE_MAX, "size_t")
+DEFINE_UNSIGNED_INTEGER_SCANNER(easyargs_scan_uint, unsigned int, UINT_MAX)
+DEFINE_UNSIGNED_INTEGER_SCANNER(easyargs_scan_ulong, unsigned long, ULONG_MAX)
+DEFINE_UNSIGNED_INTEGER_SCANNER(easyargs_scan_ullong, unsigned long long, ULLONG_MAX)
+DEFINE_UNSIGNED_INTEGER_SCANNER(easyargs_scan_size_t, size_t, SIZE_MAX)
 
-#undef DEFINE_UNSIGNED_INTEGER_PARSER
+#undef DEFINE_UNSIGNED_INTEGER_SCANNER
 
-#define DEFINE_SIGNED_INTEGER_PARSER(funcname, rettype, minval, maxval, typename) \
-static inline rettype funcname(const char* text, int* ok) { \
-    *ok = 0; \
-    if (!text) { \
-        fprintf(stderr, "Error: null input for %s.\n", typename); \
-        return 0; \
-    } \
+#define DEFINE_SIGNED_INTEGER_SCANNER(funcname, valtype, minval, maxval) \
+static inline easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
     text = easyargs_skip_leading(text); \
-    if (text[0] == '\0') { \
-        fprintf(stderr, "Error: empty input for %s.\n", typename); \
-        return 0; \
-    } \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    unsigned long long magnitude; \
+    int negative, overflow; \
+    if (!easyargs_scan_integer(text, &magnitude, &negative, &overflow)) return EASYARGS_ERR_SYNTAX; \
+    if (overflow || magnitude > (negative ? (unsigned long long)(-((minval) + 1)) + 1 : (unsigned long long)(maxval))) \
+        return EASYARGS_ERR_RANGE; \
+    /* Negate via magnitude - 1 so the most negative value does not overflow */ \
+    *value = (negative && magnitude) ? (valtype) (-(long long)(magnitude - 1) - 1) : (valtype) magnitude; \
+    return EASYARGS_OK; \
+}
+
+DEFINE_SIGNED_INTEGER_SCANNER(easyargs_scan_int, int, INT_MIN, INT_MAX)
+DEFINE_SIGNED_INTEGER_SCANNER(easyargs_scan_long, long, LONG_MIN, LONG_MAX)
+DEFINE_SIGNED_INTEGER_SCANNER(easyargs_scan_llong, long long, LLONG_MIN, LLONG_MAX)
+DEFINE_SIGNED_INTEGER_SCANNER(easyargs_scan_int64, int64_t, INT64_MIN, INT64_MAX)
+
+#undef DEFINE_SIGNED_INTEGER_SCANNER
+
+// Floats outside the fast path fall back to strtod/strtof. errno is restored afterwards.
+#define DEFINE_FLOAT_SCANNER(funcname, valtype, fastpath, strtox) \
+static inline easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
+    text = easyargs_skip_leading(text); \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    if (fastpath(text, value)) return EASYARGS_OK; \
     char* end; \
+    int saved_errno = errno; \
     errno = 0; \
-    long long val = strtoll(text, &end, 0); \
-    if (*end != '\0') { \
-        fprintf(stderr, "Error: '%s' is not a valid %s.\n", text, typename); \
-        return 0; \
-    } \
-    if (errno == ERANGE || val < (long long)(minval) || val > (long long)(maxval)) { \
-        fprintf(stderr, "Error: '%s' is out of range for %s.\n", text, typename); \
-        return 0; \
-    } \
-    *ok = 1; \
-    return (rettype) val; \
+    valtype val = strtox(text, &end); \
+    int range = errno == ERANGE; \
+    errno = saved_errno; \
+    if (range) return EASYARGS_ERR_RANGE; \
+    if (*end != '\0') return EASYARGS_ERR_SYNTAX; \
+    *value = val; \
+    return EASYARGS_OK; \
 }
 
-DEFINE_SIGNED_INTEGER_PARSER(easyargs_parse_int, int, INT_MIN, INT_MAX, "int")
-DEFINE_SIGNED_INTEGER_PARSER(easyargs_parse_long, long, LONG_MIN, LONG_MAX, "long")
-DEFINE_SIGNED_INTEGER_PARSER(easyargs_parse_llong, long long, LLONG_MIN, LLONG_MAX, "long long")
+DEFINE_FLOAT_SCANNER(easyargs_scan_float, float, easyargs_fast_float, strtof)
+DEFINE_FLOAT_SCANNER(easyargs_scan_double, double, easyargs_fast_double, strtod)
 
-#undef DEFINE_SIGNED_INTEGER_PARSER
+#undef DEFINE_FLOAT_SCANNER
 
-static inline float easyargs_parse_float(const char* text, int* ok) {
-    *ok = 0;
 
-    if (!text) {
-        fprintf(stderr, "Error: null input for float.\n");
-        return 0.0f;
-    }
-    text = easyargs_skip_leading(text);
-    if (text[0] == '\0') {
-        fprintf(stderr, "Error: empty input for float.\n");
-        return 0;
-    }
-    char* end;
-    errno = 0;
-    float value = strtof(text, &end);
-    if (errno == ERANGE) {
-        fprintf(stderr, "Error: '%s' is out of range for type float.\n", text);
-        return 0.0f;
-    }
-    if (*end != '\0') {
-        fprintf(stderr, "Error: '%s' is not a valid float.\n", text);
-        return 0.0f;
-    }
+// PARSERS
+// Wrappers over the scanners that print an error message on failure.
+// If *ok is EASYARGS_QUIET on entry, they print nothing and instead leave the negated
+// easyargs_status_t in *ok on failure. Custom parsers may ignore this and just set 0.
+#define EASYARGS_QUIET INT_MIN
+
+// Value to leave in *ok, given its value on entry
+static inline int easyargs_parser_result(int ok, easyargs_status_t status) {
+    if (status == EASYARGS_OK) return 1;
+    return ok == EASYARGS_QUIET ? -(int) status : 0;
+}
+
+// Status of a parser call made with *ok set to 0 or EASYARGS_QUIET beforehand
+static inline easyargs_status_t easyargs_parser_status(int ok) {
+    if (ok == 0 || ok == EASYARGS_QUIET) return EASYARGS_ERR_INVALID;
+    if (ok < 0 && -ok < EASYARGS_ERR_INVALID) return (easyargs_status_t) -ok;
+    return EASYARGS_OK;
+}
+
+static inline char* easyargs_parse_str(const char* text, int* ok) {
+    char* value = NULL;
+    easyargs_status_t status = easyargs_scan_str(text, &value);
+    int quiet = *ok == EASYARGS_QUIET;
+    *ok = easyargs_parser_result(*ok, status);
+
+    if (quiet)
+        return value;
+
+    if (status == EASYARGS_ERR_NULL)
+        fprintf(stderr, "Error: null string value.\n");
+    else if (status == EASYARGS_ERR_EMPTY)
+        fprintf(stderr, "Error: empty string value not allowed.\n");
 
-    *ok = 1;
     return value;
 }
 
-static inline double easyargs_parse_double(const char* text, int* ok) {
-    *ok = 0;
+static inline char easyargs_parse_char(const char* text, int* ok) {
+    char value = 0;
+    easyargs_status_t status = easyargs_scan_char(text, &value);
+    int quiet = *ok == EASYARGS_QUIET;
+    *ok = easyargs_parser_result(*ok, status);
 
-    if (!text) {
-        fprintf(stderr, "Error: null input for double.\n");
-        return 0.0;
-    }
+    if (quiet)
+        return value;
+
+    if (status == EASYARGS_ERR_NULL)
+        fprintf(stderr, "Error: null input for character argument.\n");
+    else if (status == EASYARGS_ERR_SYNTAX)
+        fprintf(stderr, "Error: '%s' is not a valid character.\n", text);
+
+    return value;
+}
+
+// Print the error for a failed numeric scan
+static inline void easyargs_report_number(easyargs_status_t status, const char* text, const char* typename) {
     text = easyargs_skip_leading(text);
-    if (text[0] == '\0') {
-        fprintf(stderr, "Error: empty input for double.\n");
-        return 0;
-    }
-    char* end;
-    errno = 0;
-    double value = strtod(text, &end);
-    if (errno == ERANGE) {
-        fprintf(stderr, "Error: '%s' is out of range for type double.\n", text);
-        return 0.0;
-    }
-    if (*end != '\0') {
-        fprintf(stderr, "Error: '%s' is not a valid double.\n", text);
-        return 0.0;
+    switch (status) {
+        case EASYARGS_ERR_NULL:
+            fprintf(stderr, "Error: null input for %s.\n", typename);
+            break;
+        case EASYARGS_ERR_EMPTY:
+            fprintf(stderr, "Error: empty input for %s.\n", typename);
+            break;
+        case EASYARGS_ERR_NEGATIVE:
+            fprintf(stderr, "Error: '%s' negative value not allowed for %s.\n", text, typename);
+            break;
+        case EASYARGS_ERR_SYNTAX:
+            fprintf(stderr, "Error: '%s' is not a valid %s.\n", text, typename);
+            break;
+        case EASYARGS_ERR_RANGE:
+            fprintf(stderr, "Error: '%s' is out of range for %s.\n", text, typename);
+            break;
+        default:
+            break;
     }
+}
 
-    *ok = 1;
-    return value;
+#define DEFINE_NUMBER_PARSER(funcname, scanner, rettype, typename, rangename) \
+static inline rettype funcname(const char* text, int* ok) { \
+    rettype value = 0; \
+    easyargs_status_t status = scanner(text, &value); \
+    int quiet = *ok == EASYARGS_QUIET; \
+    *ok = easyargs_parser_result(*ok, status); \
+    if (status != EASYARGS_OK && !quiet) \
+        easyargs_report_number(status, text, status == EASYARGS_ERR_RANGE ? rangename : typename); \
+    return value; \
 }
 
+DEFINE_NUMBER_PARSER(easyargs_parse_uint, easyargs_scan_uint, unsigned int, "unsigned int", "unsigned int")
+DEFINE_NUMBER_PARSER(easyargs_parse_ulong, easyargs_scan_ulong, unsigned long, "unsigned long", "unsigned long")
+DEFINE_NUMBER_PARSER(easyargs_parse_ullong, easyargs_scan_ullong, unsigned long long, "unsigned long long", "unsigned long long")
+DEFINE_NUMBER_PARSER(easyargs_parse_size_t, easyargs_scan_size_t, size_t, "size_t", "size_t")
+DEFINE_NUMBER_PARSER(easyargs_parse_int, easyargs_scan_int, int, "int", "int")
+DEFINE_NUMBER_PARSER(easyargs_parse_long, easyargs_scan_long, long, "long", "long")
+DEFINE_NUMBER_PARSER(easyargs_parse_llong, easyargs_scan_llong, long long, "long long", "long long")
+DEFINE_NUMBER_PARSER(easyargs_parse_float, easyargs_scan_float, float, "float", "type float")
+DEFINE_NUMBER_PARSER(easyargs_parse_double, easyargs_scan_double, double, "double", "type double")
+
+#undef DEFINE_NUMBER_PARSER
+
+// Values of a list option
+#define DEFINE_LIST_TYPE(typename, type) \
+typedef struct { \
+    type* items; \
+    int count; \
+} typename;
+
+DEFINE_LIST_TYPE(easyargs_string_list_t, char*)
+DEFINE_LIST_TYPE(easyargs_char_list_t, char)
+DEFINE_LIST_TYPE(easyargs_int_list_t, int)
+DEFINE_LIST_TYPE(easyargs_uint_list_t, unsigned int)
+DEFINE_LIST_TYPE(easyargs_long_list_t, long)
+DEFINE_LIST_TYPE(easyargs_ulong_list_t, unsigned long)
+DEFINE_LIST_TYPE(easyargs_llong_list_t, long long)
+DEFINE_LIST_TYPE(easyargs_ullong_list_t, unsigned long long)
+DEFINE_LIST_TYPE(easyargs_size_list_t, size_t)
+DEFINE_LIST_TYPE(easyargs_float_list_t, float)
+DEFINE_LIST_TYPE(easyargs_double_list_t, double)
+
+// Values of a vector option
+DEFINE_LIST_TYPE(easyargs_float_vector_t, float)
+DEFINE_LIST_TYPE(easyargs_double_vector_t, double)
+DEFINE_LIST_TYPE(easyargs_int64_vector_t, int64_t)
+
+#undef DEFINE_LIST_TYPE
+
+#endif
+
 
 // COUNT ARGUMENTS
 #ifdef REQUIRED_ARGS
@@ -243,13 +728,273 @@ static const int BOOLEAN_ARG_COUNT = 0 BOOLEAN_ARGS;
 static const int BOOLEAN_ARG_COUNT = 0;
 #endif
 
+// Defined if there are no arguments at all, e.g. when included only for the parsers. ISO C has
+// no empty structs, so args_t then holds a placeholder.
+#undef EASYARGS_NO_ARGS
+#if !defined(REQUIRED_ARGS) && !defined(OPTIONAL_ARGS) && !defined(BOOLEAN_ARGS)
+#define EASYARGS_NO_ARGS
+#endif
+
+// Defined if any option is a list or vector, so args_t holds their storage
+#undef EASYARGS_HAS_LISTS
+#ifdef OPTIONAL_ARGS
+#undef EASYARGS_TYPED_LIST
+#undef EASYARGS_TYPED_VECTOR
+#define EASYARGS_TYPED_LIST(...) + 1
+#define EASYARGS_TYPED_VECTOR(...) + 1
+#define OPTIONAL_ARG(...)
+#if (0 OPTIONAL_ARGS)
+#define EASYARGS_HAS_LISTS
+#endif
+#undef OPTIONAL_ARG
+#undef EASYARGS_TYPED_LIST
+#undef EASYARGS_TYPED_VECTOR
+#define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+#define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+#endif
+
+
+// BOOLEAN BITS
+// Define EASYARGS_PACKED_BOOLEANS before including to store boolean arguments as bits of a
+// uint64_t array at the start of args_t, instead of one _Bool field each. Read them with
+// EASYARGS_BOOLEAN(args, name), which also works without packing, or test several at once:
+//     if (args.easyargs_booleans[0] & (EASYARGS_BOOLEAN_MASK(verbose) | EASYARGS_BOOLEAN_MASK(debug)))
+// Booleans 0 to 63 are in word 0, 64 to 127 in word 1, and so on, in declaration order.
+#ifdef EASYARGS_PACKED_BOOLEANS
+
+enum {
+    #define BOOLEAN_ARG(name, ...) EASYARGS_NAME(EASYARGS_BOOL_##name),
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef BOOLEAN_ARG
+
+    EASYARGS_BOOLEAN_COUNT
+};
+
+enum { EASYARGS_BOOLEAN_WORDS = (EASYARGS_BOOLEAN_COUNT + 63) / 64 };
+
+#define EASYARGS_BOOLEAN_WORD(name) (EASYARGS_NAME(EASYARGS_BOOL_##name) / 64)
+#define EASYARGS_BOOLEAN_MASK(name) ((uint64_t) 1 << (EASYARGS_NAME(EASYARGS_BOOL_##name) % 64))
+#define EASYARGS_BOOLEAN(args, name) \
+    (((args).easyargs_booleans[EASYARGS_BOOLEAN_WORD(name)] & EASYARGS_BOOLEAN_MASK(name)) != 0)
+#define EASYARGS_SET_BOOLEAN(args, name) \
+    ((args).easyargs_booleans[EASYARGS_BOOLEAN_WORD(name)] |= EASYARGS_BOOLEAN_MASK(name))
+
+// The above follow EASYARGS_PREFIX where they are used. This reads a boolean of the schema
+// included with the given prefix, wherever it is used.
+#define EASYARGS_BOOLEAN_IN(prefix, args, name) \
+    (((args).easyargs_booleans[EASYARGS_PREFIXED(prefix, EASYARGS_BOOL_##name) / 64] & \
+      ((uint64_t) 1 << (EASYARGS_PREFIXED(prefix, EASYARGS_BOOL_##name) % 64))) != 0)
+
+#ifndef EASYARGS_COMMON_H
+// Set boolean number bit, e.g. from a table
+static inline void easyargs_set_boolean_bit(uint64_t* booleans, int bit) {
+    booleans[bit / 64] |= (uint64_t) 1 << (bit % 64);
+}
+#endif
+
+#else
+
+#define EASYARGS_BOOLEAN(args, name) ((args).name)
+#define EASYARGS_SET_BOOLEAN(args, name) ((args).name = 1)
+#define EASYARGS_BOOLEAN_IN(prefix, args, name) ((args).name)
+
+#endif
+
 
 // ARG_T STRUCT
+// Each array option gets a struct type holding its values and their count
+#undef EASYARGS_TYPED_ARRAY
+#define EASYARGS_TYPED_ARRAY(item, capacity, name, ...) \
+typedef struct { \
+    item items[capacity]; \
+    int count; \
+} EASYARGS_NAME(easyargs_array_##name);
+#define OPTIONAL_ARG(...)
+
+#ifdef OPTIONAL_ARGS
+OPTIONAL_ARGS
+#endif
+
+#undef OPTIONAL_ARG
+#undef EASYARGS_TYPED_ARRAY
+#define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+
+// Define EASYARGS_OPTIMIZE_LAYOUT before including to lay out args_t for speed rather than in
+// declaration order (needs C11 or GNU C, for anonymous members). Fields tagged with HOT(...)
+// come first, in a sub-struct aligned to a 64-byte cache line, followed by the rest. Within
+// each part, fields are ordered by descending alignment, so there is no padding between them.
+// Fields of custom types, whose alignment is unknown, come first.
+#ifdef EASYARGS_OPTIMIZE_LAYOUT
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define EASYARGS_ALIGNAS(n) _Alignas(n)
+#elif defined(_MSC_VER)
+#define EASYARGS_ALIGNAS(n) __declspec(align(n))
+#else
+#define EASYARGS_ALIGNAS(n) __attribute__((aligned(n)))
+#endif
+
+#define EASYARGS_CAT(a, b) EASYARGS_CAT_I(a, b)
+#define EASYARGS_CAT_I(a, b) a ## b
+#define EASYARGS_EXPAND(...) __VA_ARGS__
+#define EASYARGS_SECOND(a, b, ...) b
+#define EASYARGS_CHECK(...) EASYARGS_SECOND(__VA_ARGS__, 0, ~)
+
+// In this section every entry expands to a tuple (hot, class, type, name), class U being unknown.
+// Booleans stored as bits get class N, and no field.
+#undef EASYARGS_TYPED_REQUIRED
+#undef EASYARGS_TYPED_OPTIONAL
+#undef HOT
+#define EASYARGS_TYPED_REQUIRED(class, type, name, ...) (0, class, type, name)
+#define EASYARGS_TYPED_OPTIONAL(class, type, name, ...) (0, class, type, name)
+#define REQUIRED_ARG(type, name, ...) (0, U, type, name)
+#define OPTIONAL_ARG(type, name, ...) (0, U, type, name)
+#ifdef EASYARGS_PACKED_BOOLEANS
+#define BOOLEAN_ARG(name, ...) (0, N, _Bool, name)
+#else
+#define BOOLEAN_ARG(name, ...) (0, B, _Bool, name)
+#endif
+#define HOT(entry) EASYARGS_MAKE_HOT entry
+#define EASYARGS_MAKE_HOT(hot, class, type, name) (1, class, type, name)
+
+#undef EASYARGS_LAYOUT_REQUIRED
+#undef EASYARGS_LAYOUT_OPTIONAL
+#undef EASYARGS_LAYOUT_BOOLEAN
+#undef EASYARGS_HAS_HOT_LINE
+#ifdef REQUIRED_ARGS
+#define EASYARGS_LAYOUT_REQUIRED REQUIRED_ARGS
+#else
+#define EASYARGS_LAYOUT_REQUIRED
+#endif
+#ifdef OPTIONAL_ARGS
+#define EASYARGS_LAYOUT_OPTIONAL OPTIONAL_ARGS
+#else
+#define EASYARGS_LAYOUT_OPTIONAL
+#endif
+#ifdef BOOLEAN_ARGS
+#define EASYARGS_LAYOUT_BOOLEAN BOOLEAN_ARGS
+#else
+#define EASYARGS_LAYOUT_BOOLEAN
+#endif
+#define EASYARGS_LAYOUT_ENTRIES EASYARGS_LAYOUT_REQUIRED EASYARGS_LAYOUT_OPTIONAL EASYARGS_LAYOUT_BOOLEAN
+
+// Declare the fields whose hot flag and class make up EASYARGS_WANT, e.g. 1W.
+// The tuples form a sequence (a)(b)(c), walked by two macros calling each other.
+#define EASYARGS_FIELDS(entries) EASYARGS_CAT(EASYARGS_EXPAND(EASYARGS_FIELDS_A entries), 0)
+#define EASYARGS_FIELDS_A(...) EASYARGS_FIELD(__VA_ARGS__) EASYARGS_FIELDS_B
+#define EASYARGS_FIELDS_B(...) EASYARGS_FIELD(__VA_ARGS__) EASYARGS_FIELDS_A
+#define EASYARGS_FIELDS_A0
+#define EASYARGS_FIELDS_B0
+#define EASYARGS_FIELD(hot, class, type, name) \
+    EASYARGS_CAT(EASYARGS_FIELD_IF_, EASYARGS_CHECK(EASYARGS_CAT(EASYARGS_WANT_, EASYARGS_CAT(hot, EASYARGS_CAT(class, EASYARGS_CAT(_, EASYARGS_WANT))))))(type name;)
+#define EASYARGS_FIELD_IF_1(field) field
+#define EASYARGS_FIELD_IF_0(field)
+#define EASYARGS_WANT_1U_1U ~, 1
+#define EASYARGS_WANT_1W_1W ~, 1
+#define EASYARGS_WANT_1P_1P ~, 1
+#define EASYARGS_WANT_1I_1I ~, 1
+#define EASYARGS_WANT_1B_1B ~, 1
+#define EASYARGS_WANT_0U_0U ~, 1
+#define EASYARGS_WANT_0W_0W ~, 1
+#define EASYARGS_WANT_0P_0P ~, 1
+#define EASYARGS_WANT_0I_0I ~, 1
+#define EASYARGS_WANT_0B_0B ~, 1
+
+// Number of entries tagged HOT, as an expression (0 + 1 + 1 ...) usable in #if
+#define EASYARGS_HOT_COUNT(entries) (0 EASYARGS_CAT(EASYARGS_EXPAND(EASYARGS_HOT_COUNT_A entries), 0))
+#define EASYARGS_HOT_COUNT_A(...) EASYARGS_HOT_TERM(__VA_ARGS__) EASYARGS_HOT_COUNT_B
+#define EASYARGS_HOT_COUNT_B(...) EASYARGS_HOT_TERM(__VA_ARGS__) EASYARGS_HOT_COUNT_A
+#define EASYARGS_HOT_COUNT_A0
+#define EASYARGS_HOT_COUNT_B0
+#define EASYARGS_HOT_TERM(hot, ...) EASYARGS_HOT_TERM_##hot
+#define EASYARGS_HOT_TERM_1 + 1
+#define EASYARGS_HOT_TERM_0
+
+#if EASYARGS_HOT_COUNT(EASYARGS_LAYOUT_ENTRIES) || (defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS))
+#define EASYARGS_HAS_HOT_LINE
+#endif
+
+// Stores argument values
+typedef struct {
+    #ifdef EASYARGS_HAS_HOT_LINE
+    union {
+        EASYARGS_ALIGNAS(64) char easyargs_hot_line;
+        struct {
+            #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+            uint64_t easyargs_booleans[EASYARGS_BOOLEAN_WORDS];
+            #endif
+
+            #define EASYARGS_WANT 1U
+            EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+            #undef EASYARGS_WANT
+            #define EASYARGS_WANT 1W
+            EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+            #undef EASYARGS_WANT
+            #define EASYARGS_WANT 1P
+            EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+            #undef EASYARGS_WANT
+            #define EASYARGS_WANT 1I
+            EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+            #undef EASYARGS_WANT
+            #define EASYARGS_WANT 1B
+            EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+            #undef EASYARGS_WANT
+        };
+    };
+    #endif
+
+    #define EASYARGS_WANT 0U
+    EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+    #undef EASYARGS_WANT
+    #define EASYARGS_WANT 0W
+    EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+    #undef EASYARGS_WANT
+    #define EASYARGS_WANT 0P
+    EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+    #undef EASYARGS_WANT
+    #define EASYARGS_WANT 0I
+    EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+    #undef EASYARGS_WANT
+    #define EASYARGS_WANT 0B
+    EASYARGS_FIELDS(EASYARGS_LAYOUT_ENTRIES)
+    #undef EASYARGS_WANT
+
+    #ifdef EASYARGS_HAS_LISTS
+    void* easyargs_lists;  // storage of all lists, if allocated
+    #endif
+    #ifdef EASYARGS_NO_ARGS
+    char easyargs_unused;
+    #endif
+} args_t;
+
+#undef EASYARGS_TYPED_REQUIRED
+#undef EASYARGS_TYPED_OPTIONAL
+#undef HOT
+#define EASYARGS_TYPED_REQUIRED(class, ...) REQUIRED_ARG(__VA_ARGS__)
+#define EASYARGS_TYPED_OPTIONAL(class, ...) OPTIONAL_ARG(__VA_ARGS__)
+#define HOT(entry) entry
+#undef REQUIRED_ARG
+#undef OPTIONAL_ARG
+#undef BOOLEAN_ARG
+
+#else
+
 #define REQUIRED_ARG(type, name, ...) type name;
 #define OPTIONAL_ARG(type, name, ...) type name;
+#ifdef EASYARGS_PACKED_BOOLEANS
+#define BOOLEAN_ARG(...)
+#else
 #define BOOLEAN_ARG(name, ...) _Bool name;
+#endif
 // Stores argument values
 typedef struct {
+    #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+    uint64_t easyargs_booleans[EASYARGS_BOOLEAN_WORDS];
+    #endif
     #ifdef REQUIRED_ARGS
     REQUIRED_ARGS
     #endif
@@ -259,18 +1004,83 @@ typedef struct {
     #ifdef BOOLEAN_ARGS
     BOOLEAN_ARGS
     #endif
+    #ifdef EASYARGS_HAS_LISTS
+    void* easyargs_lists;  // storage of all lists, if allocated
+    #endif
+    #ifdef EASYARGS_NO_ARGS
+    char easyargs_unused;
+    #endif
 } args_t;
 #undef REQUIRED_ARG
 #undef OPTIONAL_ARG
 #undef BOOLEAN_ARG
 
+#endif
+
+// Sizes of args_t and of the padding in it, e.g. to print or to check in a test.
+// Define EASYARGS_MAX_ARGS_SIZE to make it a compile error for args_t to be larger.
+#define REQUIRED_ARG(type, ...) + sizeof(type)
+#define OPTIONAL_ARG(type, ...) + sizeof(type)
+#ifdef EASYARGS_PACKED_BOOLEANS
+#define BOOLEAN_ARG(...)
+#else
+#define BOOLEAN_ARG(...) + sizeof(_Bool)
+#endif
+enum {
+    EASYARGS_ARGS_SIZE = sizeof(args_t),
+    EASYARGS_ARGS_PADDING = sizeof(args_t) - (0
+        #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+        + sizeof(uint64_t) * EASYARGS_BOOLEAN_WORDS
+        #endif
+        #ifdef EASYARGS_HAS_LISTS
+        + sizeof(void*)
+        #endif
+        #ifdef EASYARGS_NO_ARGS
+        + sizeof(char)
+        #endif
+        #ifdef REQUIRED_ARGS
+        REQUIRED_ARGS
+        #endif
+        #ifdef OPTIONAL_ARGS
+        OPTIONAL_ARGS
+        #endif
+        #ifdef BOOLEAN_ARGS
+        BOOLEAN_ARGS
+        #endif
+    )
+};
+#undef REQUIRED_ARG
+#undef OPTIONAL_ARG
+#undef BOOLEAN_ARG
+
+#ifdef EASYARGS_MAX_ARGS_SIZE
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+_Static_assert(sizeof(args_t) <= EASYARGS_MAX_ARGS_SIZE, "args_t is larger than EASYARGS_MAX_ARGS_SIZE");
+#else
+typedef char easyargs_args_size_check[sizeof(args_t) <= EASYARGS_MAX_ARGS_SIZE ? 1 : -1];
+#endif
+#endif
+
 
 // Build an args_t struct with assigned default values
 static inline args_t make_default_args() {
     args_t args = {
         #define REQUIRED_ARG(type, name, ...) .name = (type) 0,
         #define OPTIONAL_ARG(type, name, default, ...) .name = default,
+        #ifdef EASYARGS_PACKED_BOOLEANS
+        #define BOOLEAN_ARG(...)
+        #if defined(BOOLEAN_ARGS)
+        .easyargs_booleans = { 0 },
+        #endif
+        #else
         #define BOOLEAN_ARG(name, ...) .name = 0,
+        #endif
+        #ifdef EASYARGS_HAS_LISTS
+        .easyargs_lists = NULL,
+        #endif
+        #ifdef EASYARGS_NO_ARGS
+        .easyargs_unused = 0,
+        #endif
 
         #ifdef REQUIRED_ARGS
         REQUIRED_ARGS
@@ -293,162 +1103,2767 @@ static inline args_t make_default_args() {
 }
 
 
-// Parse arguments. Returns 0 if failed.
-static inline int parse_args(int argc, char* argv[], args_t* args) {
-    if (!argc || !argv) {
-        fprintf(stderr, "Internal error: null args or argv.\n");
-        return 0;
-    }
-
-    // If not enough required arguments
-    if (argc < 1 + REQUIRED_ARG_COUNT) {
-        fprintf(stderr, "Not all required arguments included.\n");
-        return 0;
-    }
-
-    int ok;
-    int i = 1;
+// OPTION IDS
+// Every optional and boolean argument gets an id, in declaration order
+enum {
+    #define OPTIONAL_ARG(type, name, ...) EASYARGS_NAME(EASYARGS_OPT_##name),
+    #define BOOLEAN_ARG(name, ...) EASYARGS_NAME(EASYARGS_OPT_##name),
 
-    // Get required arguments
-    #ifdef REQUIRED_ARGS
-    #define REQUIRED_ARG(type, name, label, description, parser) \
-    ok = 0; \
-    args->name = (type) parser(argv[i++], &ok); \
-    if (!ok) \
-        return 0;
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
 
-    REQUIRED_ARGS
-    #undef REQUIRED_ARG
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
     #endif
 
-    // Get optional and boolean arguments
-    #define OPTIONAL_ARG(type, name, default, flag, label, description, formatter, parser) \
-    if (!strcmp(argv[i], flag)) { \
-        if (i + 1 >= argc) { \
-            fprintf(stderr, "Error: option '%s' requires a value.\n", flag); \
-            return 0; \
-        } \
-        ok = 0; \
-        args->name = (type) parser(argv[++i], &ok); \
-        if (!ok) \
-            return 0; \
-        continue; \
-    }
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
 
-    #define BOOLEAN_ARG(name, flag, description) \
-    if (!strcmp(argv[i], flag)) { \
-        args->name = 1; \
-        continue; \
+    EASYARGS_OPTION_COUNT
+};
+
+// FLAG COMPARISON
+// Tokens shorter than a SIMD register are compared against padded flags with one vector compare.
+// Copying the token costs more than it saves for small schemas, so the vector path is only used
+// with at least EASYARGS_SIMD_MIN_OPTIONS options. Define EASYARGS_NO_SIMD to always use memcmp.
+#if !defined(EASYARGS_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define EASYARGS_SIMD_WIDTH 32
+#elif !defined(EASYARGS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define EASYARGS_SIMD_WIDTH 16
+#else
+#define EASYARGS_SIMD_WIDTH 0
+#endif
+
+#ifndef EASYARGS_SIMD_MIN_OPTIONS
+#define EASYARGS_SIMD_MIN_OPTIONS 100
+#endif
+
+// Whether a token of this length is compared by vector; constant except for the length
+#define EASYARGS_VECTOR_COMPARE(len) (EASYARGS_SIMD_WIDTH && EASYARGS_OPTION_COUNT >= EASYARGS_SIMD_MIN_OPTIONS && (len) < EASYARGS_SIMD_WIDTH)
+
+#define EASYARGS_PADDED_SIZE(size) (EASYARGS_VECTOR_COMPARE((size) - 1) ? EASYARGS_SIMD_WIDTH : (size))
+
+// A token loaded once for comparison against many flags
+typedef struct {
+    const char* text;
+    size_t len;
+    #if EASYARGS_SIMD_WIDTH == 32
+    __m256i padded;
+    #elif EASYARGS_SIMD_WIDTH == 16
+    __m128i padded;
+    #endif
+} easyargs_token_t;
+
+static inline void easyargs_load_token(easyargs_token_t* token, const char* text, size_t len) {
+    token->text = text;
+    token->len = len;
+
+    // Copy short tokens into a zeroed register-sized buffer; longer ones are never compared by vector
+    #if EASYARGS_SIMD_WIDTH
+    if (EASYARGS_VECTOR_COMPARE(len)) {
+        union {
+            char bytes[EASYARGS_SIMD_WIDTH];
+            #if EASYARGS_SIMD_WIDTH == 32
+            __m256i vector;
+            #else
+            __m128i vector;
+            #endif
+        } buffer;
+        memset(buffer.bytes, 0, sizeof(buffer.bytes));
+        memcpy(buffer.bytes, text, len);
+        token->padded = buffer.vector;
+    }
+    #endif
+}
+
+// Compare a loaded token against a flag stored in EASYARGS_PADDED_SIZE bytes
+static inline int easyargs_token_equals(const easyargs_token_t* token, const char* padded_flag, size_t flag_len) {
+    if (token->len != flag_len)
+        return 0;
+
+    #if EASYARGS_SIMD_WIDTH == 32
+    if (EASYARGS_VECTOR_COMPARE(flag_len)) {
+        __m256i flag = _mm256_loadu_si256((const __m256i*) padded_flag);
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(token->padded, flag)) == -1;
+    }
+    #elif EASYARGS_SIMD_WIDTH == 16
+    if (EASYARGS_VECTOR_COMPARE(flag_len)) {
+        __m128i flag = _mm_loadu_si128((const __m128i*) padded_flag);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(token->padded, flag)) == 0xFFFF;
+    }
+    #endif
+
+    return !memcmp(token->text, padded_flag, flag_len);
+}
+
+
+// Flag literals, zero-padded to a full SIMD register when they will be compared by vector
+#define OPTIONAL_ARG(type, name, default, flag, ...) static const char EASYARGS_NAME(easyargs_flag_##name)[EASYARGS_PADDED_SIZE(sizeof(flag))] = flag;
+#define BOOLEAN_ARG(name, flag, ...) static const char EASYARGS_NAME(easyargs_flag_##name)[EASYARGS_PADDED_SIZE(sizeof(flag))] = flag;
+
+#ifdef OPTIONAL_ARGS
+OPTIONAL_ARGS
+#endif
+
+#ifdef BOOLEAN_ARGS
+BOOLEAN_ARGS
+#endif
+
+#undef OPTIONAL_ARG
+#undef BOOLEAN_ARG
+
+// Flags and their lengths, indexed by option id (NULL-terminated)
+static const char* const easyargs_option_flags[EASYARGS_OPTION_COUNT + 1] = {
+    #define OPTIONAL_ARG(type, name, ...) EASYARGS_NAME(easyargs_flag_##name),
+    #define BOOLEAN_ARG(name, ...) EASYARGS_NAME(easyargs_flag_##name),
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+
+    NULL
+};
+
+static const size_t easyargs_option_flag_lengths[EASYARGS_OPTION_COUNT + 1] = {
+    #define OPTIONAL_ARG(type, name, default, flag, ...) sizeof(flag) - 1,
+    #define BOOLEAN_ARG(name, flag, ...) sizeof(flag) - 1,
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+
+    0
+};
+
+
+// VECTOR VALUES
+// The value of a vector option is split at commas found 16 bytes at a time, and each element
+// goes through the same scanner as a single value. The scanners need terminated text, so each
+// element is copied to a buffer on the stack first; elements longer than
+// EASYARGS_VECTOR_ELEMENT_MAX characters are syntax errors.
+#ifndef EASYARGS_COMMON_H
+
+#ifndef EASYARGS_VECTOR_ALIGNMENT
+#define EASYARGS_VECTOR_ALIGNMENT 64
+#endif
+
+#ifndef EASYARGS_VECTOR_ELEMENT_MAX
+#define EASYARGS_VECTOR_ELEMENT_MAX 255
+#endif
+
+// Number of commas in text. Only whole blocks inside the string are loaded.
+static inline size_t easyargs_count_commas(const char* text) {
+    size_t len = strlen(text);
+    size_t count = 0;
+    size_t i = 0;
+    #if EASYARGS_SIMD_WIDTH
+    // Per-byte counts for up to 255 blocks at a time
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i comma = _mm_set1_epi8(',');
+    while (i + 16 <= len) {
+        size_t blocks = (len - i) / 16;
+        if (blocks > 255)
+            blocks = 255;
+        __m128i sums = zero;
+        for (size_t b = 0; b < blocks; b++, i += 16)
+            sums = _mm_sub_epi8(sums, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (text + i)), comma));
+        __m128i total = _mm_sad_epu8(sums, zero);
+        count += (size_t) _mm_cvtsi128_si32(total) + (size_t) _mm_extract_epi16(total, 4);
+    }
+    #endif
+    for (; i < len; i++)
+        count += text[i] == ',';
+    return count;
+}
+
+// Position of the first comma in text[from, len), or len if there is none
+static inline size_t easyargs_find_comma(const char* text, size_t from, size_t len) {
+    #if EASYARGS_SIMD_WIDTH
+    const __m128i comma = _mm_set1_epi8(',');
+    for (; from + 16 <= len; from += 16) {
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (text + from)), comma));
+        if (mask) {
+            for (; !(mask & 1); mask >>= 1)
+                from++;
+            return from;
+        }
+    }
+    #endif
+    while (from < len && text[from] != ',')
+        from++;
+    return from;
+}
+
+// Scan the comma-separated values of text into items, returning how many were stored. *ok
+// is set as by the parsers, and the first element that fails stops the scan.
+#define DEFINE_VECTOR_PARSER(funcname, scanner, valtype, typename, rangename) \
+static inline int funcname(const char* text, valtype* items, int* ok) { \
+    char element[EASYARGS_VECTOR_ELEMENT_MAX + 1]; \
+    const char* shown = text; \
+    int count = 0; \
+    easyargs_status_t status = EASYARGS_ERR_NULL; \
+    size_t len = text ? strlen(text) : 0; \
+    for (size_t start = 0; text; start++) { \
+        size_t end = easyargs_find_comma(text, start, len); \
+        if (end - start > EASYARGS_VECTOR_ELEMENT_MAX) { \
+            status = EASYARGS_ERR_SYNTAX; \
+            shown = text; \
+            break; \
+        } \
+        memcpy(element, text + start, end - start); \
+        element[end - start] = '\0'; \
+        shown = element; \
+        status = scanner(element, &items[count]); \
+        if (status != EASYARGS_OK || end == len) \
+            break; \
+        count++; \
+        start = end; \
+    } \
+    count += status == EASYARGS_OK; \
+    int quiet = *ok == EASYARGS_QUIET; \
+    *ok = easyargs_parser_result(*ok, status); \
+    if (status != EASYARGS_OK && !quiet) \
+        easyargs_report_number(status, shown, status == EASYARGS_ERR_RANGE ? rangename : typename); \
+    return count; \
+}
+
+DEFINE_VECTOR_PARSER(easyargs_parse_float_vector, easyargs_scan_float, float, "float", "type float")
+DEFINE_VECTOR_PARSER(easyargs_parse_double_vector, easyargs_scan_double, double, "double", "type double")
+DEFINE_VECTOR_PARSER(easyargs_parse_int64_vector, easyargs_scan_int64, int64_t, "int64_t", "int64_t")
+
+#undef DEFINE_VECTOR_PARSER
+
+#endif
+
+
+// OPTION TABLE
+// Define EASYARGS_TABLE_DRIVEN before including to parse and print help from a static descriptor
+// table walked by one loop, instead of code expanded per option. This keeps parse_args and
+// print_help small for programs with hundreds of options.
+#ifdef EASYARGS_TABLE_DRIVEN
+
+#ifndef EASYARGS_COMMON_H
+enum {
+    EASYARGS_KIND_VALUE,
+    EASYARGS_KIND_BOOLEAN,
+    EASYARGS_KIND_LIST   // a list, array or vector option, which may be repeated
+};
+
+typedef struct {
+    const char* flag;
+    unsigned short flag_len;
+    unsigned short label_len;
+    unsigned char kind;
+    size_t offset;                            // of the field in args_t, or the bit of a packed boolean
+    int (*store)(const char* text, void* field, int ok); // parses text into the field; returns the parser's *ok
+    void (*append_default)(easyargs_text_t* text);
+    const char* label;
+    const char* description;
+} easyargs_option_t;
+#endif
+
+// Small per-option adapters giving every parser and default the same signature
+#define OPTIONAL_ARG(type, name, default, flag, label, description, formatter, parser) \
+static int EASYARGS_NAME(easyargs_store_##name)(const char* text, void* field, int ok) { \
+    *(type*) field = (type) parser(text, &ok); \
+    return ok; \
+} \
+static void EASYARGS_NAME(easyargs_append_default_##name)(easyargs_text_t* text) { \
+    easyargs_appendf(text, formatter, default); \
+}
+#define BOOLEAN_ARG(...)
+
+// A list appends to the space counted for it before parsing; lists have no default to print
+#undef EASYARGS_TYPED_LIST
+#define EASYARGS_TYPED_LIST(item, list, name, flag, label, description, parser) \
+static int EASYARGS_NAME(easyargs_store_##name)(const char* text, void* field, int ok) { \
+    list* values = (list*) field; \
+    values->items[values->count] = (item) parser(text, &ok); \
+    if (easyargs_parser_status(ok) == EASYARGS_OK) \
+        values->count++; \
+    return ok; \
+}
+
+// An array checks its capacity first. Its default is its capacity.
+#undef EASYARGS_TYPED_ARRAY
+#define EASYARGS_TYPED_ARRAY(item, capacity, name, flag, label, description, parser) \
+static int EASYARGS_NAME(easyargs_store_##name)(const char* text, void* field, int ok) { \
+    EASYARGS_NAME(easyargs_array_##name)* values = (EASYARGS_NAME(easyargs_array_##name)*) field; \
+    if (values->count == (capacity)) \
+        return -(int) EASYARGS_ERR_TOO_MANY; \
+    values->items[values->count] = (item) parser(text, &ok); \
+    if (easyargs_parser_status(ok) == EASYARGS_OK) \
+        values->count++; \
+    return ok; \
+} \
+static void EASYARGS_NAME(easyargs_append_default_##name)(easyargs_text_t* text) { \
+    easyargs_appendf(text, ", at most %d", (int) (capacity)); \
+}
+
+// A vector appends all the values of text. Its default says they are comma-separated.
+#undef EASYARGS_TYPED_VECTOR
+#define EASYARGS_TYPED_VECTOR(item, vector, name, flag, label, description, parser) \
+static int EASYARGS_NAME(easyargs_store_##name)(const char* text, void* field, int ok) { \
+    vector* values = (vector*) field; \
+    values->count += parser(text, values->items + values->count, &ok); \
+    return ok; \
+} \
+static void EASYARGS_NAME(easyargs_append_default_##name)(easyargs_text_t* text) { \
+    easyargs_appendf(text, ", comma-separated"); \
+}
+
+#ifdef OPTIONAL_ARGS
+OPTIONAL_ARGS
+#endif
+
+#undef OPTIONAL_ARG
+#undef BOOLEAN_ARG
+#undef EASYARGS_TYPED_LIST
+#undef EASYARGS_TYPED_ARRAY
+#undef EASYARGS_TYPED_VECTOR
+#define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+#define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+#define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+
+// Descriptors, indexed by option id
+static const easyargs_option_t easyargs_options[EASYARGS_OPTION_COUNT + 1] = {
+    #define OPTIONAL_ARG(type, name, default, flag, label, description, ...) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, sizeof(label) - 1, EASYARGS_KIND_VALUE, offsetof(args_t, name), \
+      EASYARGS_NAME(easyargs_store_##name), EASYARGS_NAME(easyargs_append_default_##name), label, description },
+    #undef EASYARGS_TYPED_LIST
+    #define EASYARGS_TYPED_LIST(item, list, name, flag, label, description, ...) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, sizeof(label) - 1, EASYARGS_KIND_LIST, offsetof(args_t, name), \
+      EASYARGS_NAME(easyargs_store_##name), NULL, label, description },
+    #undef EASYARGS_TYPED_ARRAY
+    #define EASYARGS_TYPED_ARRAY(item, capacity, name, flag, label, description, ...) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, sizeof(label) - 1, EASYARGS_KIND_LIST, offsetof(args_t, name), \
+      EASYARGS_NAME(easyargs_store_##name), EASYARGS_NAME(easyargs_append_default_##name), label, description },
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, flag, label, description, ...) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, sizeof(label) - 1, EASYARGS_KIND_LIST, offsetof(args_t, name), \
+      EASYARGS_NAME(easyargs_store_##name), EASYARGS_NAME(easyargs_append_default_##name), label, description },
+    #ifdef EASYARGS_PACKED_BOOLEANS
+    #define BOOLEAN_ARG(name, flag, description) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, 0, EASYARGS_KIND_BOOLEAN, EASYARGS_NAME(EASYARGS_BOOL_##name), NULL, NULL, "", description },
+    #else
+    #define BOOLEAN_ARG(name, flag, description) \
+    { EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1, 0, EASYARGS_KIND_BOOLEAN, offsetof(args_t, name), NULL, NULL, "", description },
+    #endif
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_ARRAY
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+    #define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+    #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+
+    { NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL }
+};
+
+#endif
+
+
+// FLAG PROFILE
+// Define EASYARGS_PROFILE as a file path before including to count how often each flag matches.
+// At exit, the counts are added to those already in the file, which is rewritten as a header
+// listing the options that matched, hottest first. Counters are shared, unsynchronized, and per
+// translation unit, so this is for instrumented builds only.
+//
+// Define EASYARGS_PROFILE_USE as the path of such a header to match flags in that order. The
+// compare chain and table scan try them first, and the hash table gives them their home slots.
+// Options missing from the profile are tried afterwards, in declaration order, so each flag is
+// compared at most once.
+//
+// The file holds one schema's counts and order, so neither works with EASYARGS_PREFIX.
+#if defined(EASYARGS_PROFILE) && defined(EASYARGS_PROFILE_USE)
+#error "Define at most one of EASYARGS_PROFILE and EASYARGS_PROFILE_USE"
+#endif
+
+#if defined(EASYARGS_PREFIX) && (defined(EASYARGS_PROFILE) || defined(EASYARGS_PROFILE_USE))
+#error "EASYARGS_PROFILE and EASYARGS_PROFILE_USE cannot be combined with EASYARGS_PREFIX"
+#endif
+
+#ifdef EASYARGS_PROFILE
+
+// Option names, indexed by option id
+static const char* const easyargs_option_names[EASYARGS_OPTION_COUNT + 1] = {
+    #define OPTIONAL_ARG(type, name, ...) #name,
+    #define BOOLEAN_ARG(name, ...) #name,
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+
+    NULL
+};
+
+static unsigned long long easyargs_profile_hits[EASYARGS_OPTION_COUNT + 1];
+
+#define EASYARGS_PROFILE_HIT(id) (easyargs_profile_hits[id]++)
+
+static inline void easyargs_write_profile(void) {
+    // Add the counts of earlier runs
+    unsigned long long hits[EASYARGS_OPTION_COUNT + 1];
+    memcpy(hits, easyargs_profile_hits, sizeof(hits));
+    FILE* file = fopen(EASYARGS_PROFILE, "r");
+    if (file) {
+        char line[256];
+        char name[128];
+        unsigned long long count;
+        while (fgets(line, sizeof(line), file)) {
+            if (sscanf(line, " EASYARGS_PROFILED(%127[^,], %llu)", name, &count) != 2)
+                continue;
+            for (int id = 0; id < EASYARGS_OPTION_COUNT; id++) {
+                if (!strcmp(name, easyargs_option_names[id]))
+                    hits[id] += count;
+            }
+        }
+        fclose(file);
+    }
+
+    // Hottest first; ties keep declaration order, so the first of duplicate flags still wins
+    int order[EASYARGS_OPTION_COUNT + 1];
+    for (int i = 0; i < EASYARGS_OPTION_COUNT; i++) {
+        int id = i;
+        int j = i;
+        for (; j > 0 && hits[order[j - 1]] < hits[id]; j--)
+            order[j] = order[j - 1];
+        order[j] = id;
+    }
+
+    file = fopen(EASYARGS_PROFILE, "w");
+    if (!file)
+        return;
+    fprintf(file, "// Flag match counts recorded with EASYARGS_PROFILE, hottest first.\n");
+    fprintf(file, "// Define EASYARGS_PROFILE_USE as the path of this file to match flags in this order.\n\n");
+    fprintf(file, "#define EASYARGS_PROFILE_ORDER \\\n");
+    for (int i = 0; i < EASYARGS_OPTION_COUNT && hits[order[i]]; i++)
+        fprintf(file, "    EASYARGS_PROFILED(%s, %llu) \\\n", easyargs_option_names[order[i]], hits[order[i]]);
+    fprintf(file, "\n");
+    fclose(file);
+}
+
+// Write the profile at exit, registering only once
+static inline void easyargs_start_profile(void) {
+    static int started = 0;
+    if (!started) {
+        started = 1;
+        atexit(easyargs_write_profile);
+    }
+}
+
+#else
+#define EASYARGS_PROFILE_HIT(id) ((void) 0)
+#define easyargs_start_profile() ((void) 0)
+#endif
+
+#ifdef EASYARGS_PROFILE_USE
+#undef EASYARGS_PROFILE_ORDER
+#include EASYARGS_PROFILE_USE
+
+// Option ids, hottest first
+static const int easyargs_profile_order[] = {
+    #define EASYARGS_PROFILED(name, count) EASYARGS_NAME(EASYARGS_OPT_##name),
+    EASYARGS_PROFILE_ORDER
+    #undef EASYARGS_PROFILED
+    -1
+};
+
+enum { EASYARGS_PROFILED_COUNT = sizeof(easyargs_profile_order) / sizeof(easyargs_profile_order[0]) - 1 };
+
+// Whether each option id is in the profile, so the declaration-order pass can skip it
+static const unsigned char easyargs_profiled[EASYARGS_OPTION_COUNT + 1] = {
+    [EASYARGS_OPTION_COUNT] = 0,
+    #define EASYARGS_PROFILED(name, count) [EASYARGS_NAME(EASYARGS_OPT_##name)] = 1,
+    EASYARGS_PROFILE_ORDER
+    #undef EASYARGS_PROFILED
+};
+#endif
+
+
+// FLAG DISPATCH
+#if defined(EASYARGS_HASH_DISPATCH) && defined(EASYARGS_DFA_DISPATCH)
+#error "Define at most one of EASYARGS_HASH_DISPATCH and EASYARGS_DFA_DISPATCH"
+#endif
+
+// Define EASYARGS_HASH_DISPATCH before including to look flags up in a hash table
+// instead of comparing each token against every flag in turn.
+#ifdef EASYARGS_HASH_DISPATCH
+
+// Table size: smallest power of two at least twice the number of options
+#define EASYARGS_HASH_SLOTS_FOR(n) \
+    ((n) <= 4 ? 8 : (n) <= 8 ? 16 : (n) <= 16 ? 32 : (n) <= 32 ? 64 : (n) <= 64 ? 128 : \
+     (n) <= 128 ? 256 : (n) <= 256 ? 512 : (n) <= 512 ? 1024 : (n) <= 1024 ? 2048 : \
+     (n) <= 2048 ? 4096 : (n) <= 4096 ? 8192 : (n) <= 8192 ? 16384 : (n) <= 16384 ? 32768 : 65536)
+
+enum { EASYARGS_HASH_SLOTS = EASYARGS_HASH_SLOTS_FOR(EASYARGS_OPTION_COUNT) };
+
+// Open-addressed table of option ids, at most half full. Slots hold id + 1; 0 is empty.
+typedef struct {
+    unsigned short slots[EASYARGS_HASH_SLOTS];
+} easyargs_dispatch_t;
+
+// FNV-1a
+static inline uint32_t easyargs_hash(const char* text, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char) text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline void easyargs_insert_option(easyargs_dispatch_t* dispatch, int id) {
+    uint32_t slot = easyargs_hash(easyargs_option_flags[id], easyargs_option_flag_lengths[id]) & (EASYARGS_HASH_SLOTS - 1);
+    while (dispatch->slots[slot])
+        slot = (slot + 1) & (EASYARGS_HASH_SLOTS - 1);
+    dispatch->slots[slot] = (unsigned short) (id + 1);
+}
+
+static inline void easyargs_build_dispatch(easyargs_dispatch_t* dispatch) {
+    memset(dispatch->slots, 0, sizeof(dispatch->slots));
+
+    // Insert in declaration order so the first of any duplicate flags wins, as with the compare chain.
+    // With a profile, hot flags go in first, so they are found in their home slot.
+    #ifdef EASYARGS_PROFILE_USE
+    unsigned char inserted[EASYARGS_OPTION_COUNT + 1] = { 0 };
+    for (int i = 0; i < EASYARGS_PROFILED_COUNT; i++) {
+        easyargs_insert_option(dispatch, easyargs_profile_order[i]);
+        inserted[easyargs_profile_order[i]] = 1;
+    }
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++) {
+        if (!inserted[id])
+            easyargs_insert_option(dispatch, id);
+    }
+    #else
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++)
+        easyargs_insert_option(dispatch, id);
+    #endif
+}
+
+// Look up the option whose flag is exactly the first len bytes of token. Returns its id, or -1.
+static inline int easyargs_find_option(const easyargs_dispatch_t* dispatch, const char* token, size_t len) {
+    uint32_t slot = easyargs_hash(token, len) & (EASYARGS_HASH_SLOTS - 1);
+    while (dispatch->slots[slot]) {
+        int id = dispatch->slots[slot] - 1;
+        if (easyargs_option_flag_lengths[id] == len && !memcmp(token, easyargs_option_flags[id], len))
+            return id;
+        slot = (slot + 1) & (EASYARGS_HASH_SLOTS - 1);
+    }
+    return -1;
+}
+
+#else
+
+// The compare chain, table scan and generated trie need no state
+typedef struct {
+    char unused;
+} easyargs_dispatch_t;
+
+static inline void easyargs_build_dispatch(easyargs_dispatch_t* dispatch) {
+    (void) dispatch;
+}
+
+// Define EASYARGS_DFA_DISPATCH as the path of a file generated by tools/easyargs_dfa.c to match
+// tokens with a byte-level trie, examining each byte at most once.
+#if defined(EASYARGS_DFA_DISPATCH)
+#include EASYARGS_DFA_DISPATCH
+#elif defined(EASYARGS_TABLE_DRIVEN)
+
+// Look up the option whose flag is exactly the first len bytes of token. Returns its id, or -1.
+static inline int easyargs_find_option(const easyargs_dispatch_t* dispatch, const char* token, size_t len) {
+    (void) dispatch;
+
+    easyargs_token_t loaded;
+    easyargs_load_token(&loaded, token, len);
+
+    #ifdef EASYARGS_PROFILE_USE
+    for (int i = 0; i < EASYARGS_PROFILED_COUNT; i++) {
+        int id = easyargs_profile_order[i];
+        if (easyargs_token_equals(&loaded, easyargs_options[id].flag, easyargs_options[id].flag_len))
+            return id;
+    }
+
+    // The rest, in declaration order
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++) {
+        if (!easyargs_profiled[id] && easyargs_token_equals(&loaded, easyargs_options[id].flag, easyargs_options[id].flag_len))
+            return id;
+    }
+    #else
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++) {
+        if (easyargs_token_equals(&loaded, easyargs_options[id].flag, easyargs_options[id].flag_len))
+            return id;
+    }
+    #endif
+
+    return -1;
+}
+
+#else
+
+// Look up the option whose flag is exactly the first len bytes of token. Returns its id, or -1.
+static inline int easyargs_find_option(const easyargs_dispatch_t* dispatch, const char* token, size_t len) {
+    (void) dispatch;
+
+    easyargs_token_t loaded;
+    easyargs_load_token(&loaded, token, len);
+
+    // Hot flags first. Their lengths come from a constant table, so they fold to constants too.
+    #ifdef EASYARGS_PROFILE_USE
+    #define EASYARGS_PROFILED(name, count) \
+    if (len == easyargs_option_flag_lengths[EASYARGS_NAME(EASYARGS_OPT_##name)] && \
+        easyargs_token_equals(&loaded, EASYARGS_NAME(easyargs_flag_##name), easyargs_option_flag_lengths[EASYARGS_NAME(EASYARGS_OPT_##name)])) \
+        return EASYARGS_NAME(EASYARGS_OPT_##name);
+
+    EASYARGS_PROFILE_ORDER
+
+    #undef EASYARGS_PROFILED
+    #define EASYARGS_UNPROFILED(name) !easyargs_profiled[EASYARGS_NAME(EASYARGS_OPT_##name)]
+    #else
+    #define EASYARGS_UNPROFILED(name) 1
+    #endif
+
+    // Flag lengths are compile-time constants, so most candidates are rejected without touching
+    // token. Whether a flag was profiled is constant too, so those tried above drop out entirely.
+    #define OPTIONAL_ARG(type, name, default, flag, ...) \
+    if (EASYARGS_UNPROFILED(name) && len == sizeof(flag) - 1 && easyargs_token_equals(&loaded, EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1)) \
+        return EASYARGS_NAME(EASYARGS_OPT_##name);
+
+    #define BOOLEAN_ARG(name, flag, ...) \
+    if (EASYARGS_UNPROFILED(name) && len == sizeof(flag) - 1 && easyargs_token_equals(&loaded, EASYARGS_NAME(easyargs_flag_##name), sizeof(flag) - 1)) \
+        return EASYARGS_NAME(EASYARGS_OPT_##name);
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+    #undef EASYARGS_UNPROFILED
+
+    return -1;
+}
+
+#endif
+#endif
+
+
+// TOKEN CLASSIFICATION
+// Before dispatch, argv is classified a block at a time: each token's shape, length, and
+// position of its first '=' are found up front. With many options, a Bloom filter over the
+// flags marks tokens that might match, so the others skip the compare chain. The hash table
+// and generated trie reject unknown tokens cheaply themselves, so they skip the filter.
+#ifndef EASYARGS_COMMON_H
+enum {
+    EASYARGS_TOKEN_POSITIONAL = 0,   // does not start with '-', or is "-"
+    EASYARGS_TOKEN_SHORT = 1,        // -x...
+    EASYARGS_TOKEN_LONG = 2,         // --x...
+    EASYARGS_TOKEN_TERMINATOR = 3,   // -- alone
+    EASYARGS_TOKEN_SHAPE = 3,        // mask for the above
+    EASYARGS_TOKEN_SPLIT = 4,        // contains '='
+    EASYARGS_TOKEN_MAY_MATCH = 8,    // the whole token may be a flag
+    EASYARGS_TOKEN_PREFIX_MAY_MATCH = 16 // the part before '=' may be a flag
+};
+#endif
+
+// Below this many options, matching is cheaper than filtering
+#ifndef EASYARGS_FILTER_MIN_OPTIONS
+#define EASYARGS_FILTER_MIN_OPTIONS 32
+#endif
+
+#undef EASYARGS_USE_FILTER
+#if defined(EASYARGS_HASH_DISPATCH) || defined(EASYARGS_DFA_DISPATCH)
+#define EASYARGS_USE_FILTER 0
+#else
+#define EASYARGS_USE_FILTER (EASYARGS_OPTION_COUNT >= EASYARGS_FILTER_MIN_OPTIONS)
+#endif
+
+// About 16 bits per flag, two set by each, for roughly 1.5% false positives
+enum { EASYARGS_FILTER_WORDS = EASYARGS_OPTION_COUNT / 4 + 1 };
+
+typedef struct {
+    uint64_t bits[EASYARGS_FILTER_WORDS];
+} easyargs_filter_t;
+
+// Hash of a token's length and its first and last 8 bytes. Flags that differ only in
+// the middle share a hash, which only costs a false positive.
+static inline uint32_t easyargs_filter_hash(const char* token, size_t len) {
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    if (len >= 8) {
+        memcpy(&head, token, 8);
+        memcpy(&tail, token + len - 8, 8);
+    } else {
+        for (size_t i = 0; i < len; i++)
+            head |= (uint64_t) (unsigned char) token[i] << (8 * i);
+    }
+    uint64_t hash = ((head * 0x9E3779B97F4A7C15u) ^ tail ^ len) * 0xC2B2AE3D27D4EB4Fu;
+    return (uint32_t) (hash >> 32);
+}
+
+// Bit positions of the two probes, scaled into the filter without a division
+#define EASYARGS_FILTER_PROBE(hash) ((size_t) (((uint64_t) (hash) * (EASYARGS_FILTER_WORDS * 64)) >> 32))
+
+static inline void easyargs_filter_add(easyargs_filter_t* filter, uint32_t hash) {
+    size_t first = EASYARGS_FILTER_PROBE(hash);
+    size_t second = EASYARGS_FILTER_PROBE(hash * 0x9E3779B1u);
+    filter->bits[first / 64] |= (uint64_t) 1 << (first % 64);
+    filter->bits[second / 64] |= (uint64_t) 1 << (second % 64);
+}
+
+static inline int easyargs_filter_test(const easyargs_filter_t* filter, uint32_t hash) {
+    size_t first = EASYARGS_FILTER_PROBE(hash);
+    size_t second = EASYARGS_FILTER_PROBE(hash * 0x9E3779B1u);
+    return (filter->bits[first / 64] >> (first % 64)) & (filter->bits[second / 64] >> (second % 64)) & 1;
+}
+
+static inline void easyargs_build_filter(easyargs_filter_t* filter) {
+    memset(filter->bits, 0, sizeof(filter->bits));
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++)
+        easyargs_filter_add(filter, easyargs_filter_hash(easyargs_option_flags[id], easyargs_option_flag_lengths[id]));
+}
+
+#ifndef EASYARGS_COMMON_H
+enum { EASYARGS_CLASSIFY_BLOCK = 256 };
+#endif
+
+// Classification of argv[start] to argv[end - 1]
+typedef struct {
+    int start;
+    int end;
+    unsigned char kinds[EASYARGS_CLASSIFY_BLOCK];
+    size_t lengths[EASYARGS_CLASSIFY_BLOCK];
+    size_t prefixes[EASYARGS_CLASSIFY_BLOCK];  // length before the first '=', if split
+} easyargs_tokens_t;
+
+static inline int easyargs_token_shape(const char* token, size_t len) {
+    if (token[0] != '-' || len < 2)
+        return EASYARGS_TOKEN_POSITIONAL;
+    if (token[1] != '-')
+        return EASYARGS_TOKEN_SHORT;
+    return len == 2 ? EASYARGS_TOKEN_TERMINATOR : EASYARGS_TOKEN_LONG;
+}
+
+// Store a token whose length and first '=' (or NULL) are already known
+static inline void easyargs_store_token(easyargs_tokens_t* tokens, const easyargs_filter_t* filter, int index,
+                                        const char* token, size_t len, const char* equals) {
+    size_t prefix = equals ? (size_t) (equals - token) : len;
+    int kind = easyargs_token_shape(token, len);
+
+    if (EASYARGS_USE_FILTER) {
+        if (easyargs_filter_test(filter, easyargs_filter_hash(token, len)))
+            kind |= EASYARGS_TOKEN_MAY_MATCH;
+        if (equals && easyargs_filter_test(filter, easyargs_filter_hash(token, prefix)))
+            kind |= EASYARGS_TOKEN_PREFIX_MAY_MATCH;
+    } else {
+        kind |= EASYARGS_TOKEN_MAY_MATCH;
+        if (equals)
+            kind |= EASYARGS_TOKEN_PREFIX_MAY_MATCH;
+    }
+    if (equals)
+        kind |= EASYARGS_TOKEN_SPLIT;
+
+    tokens->kinds[index] = (unsigned char) kind;
+    tokens->lengths[index] = len;
+    tokens->prefixes[index] = prefix;
+}
+
+#ifdef EASYARGS_CONTIGUOUS_ARGV
+// On Linux, the kernel copies the argv strings back to back, each followed by its NUL. When
+// argv is laid out that way, each length is just the distance to the next pointer. One vector
+// pass over the whole block then counts the NULs, which proves there are none inside the
+// strings, and counts the '=' signs, so lists with none skip looking for them per token.
+// The pass only reads aligned blocks of pages the strings occupy (pages are at least 4 KiB),
+// but it does read a few bytes around the strings, like strlen itself, which sanitizers flag.
+#if EASYARGS_SIMD_WIDTH
+// Count the NUL and '=' bytes in [begin, end). Whole aligned blocks are counted in per-byte
+// vector counters, then the few bytes outside the range in the first and last blocks are
+// taken back off.
+static inline void easyargs_count_bytes(const char* begin, const char* end, size_t* nuls, size_t* equals) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i equal = _mm_set1_epi8('=');
+    const char* first = (const char*) ((uintptr_t) begin & ~(uintptr_t) 15);
+    const char* stop = (const char*) (((uintptr_t) end + 15) & ~(uintptr_t) 15);
+
+    size_t nul_count = 0;
+    size_t equal_count = 0;
+    for (const char* block = first; block < stop;) {
+        // At most 255 blocks per round, so the byte counters can't overflow
+        size_t blocks = (size_t) (stop - block) / 16;
+        if (blocks > 255)
+            blocks = 255;
+
+        __m128i nul_sums = zero;
+        __m128i equal_sums = zero;
+        for (size_t i = 0; i < blocks; i++, block += 16) {
+            __m128i bytes = _mm_load_si128((const __m128i*) block);
+            nul_sums = _mm_sub_epi8(nul_sums, _mm_cmpeq_epi8(bytes, zero));
+            equal_sums = _mm_sub_epi8(equal_sums, _mm_cmpeq_epi8(bytes, equal));
+        }
+
+        __m128i nul_total = _mm_sad_epu8(nul_sums, zero);
+        __m128i equal_total = _mm_sad_epu8(equal_sums, zero);
+        nul_count += (size_t) _mm_cvtsi128_si32(nul_total) + (size_t) _mm_extract_epi16(nul_total, 4);
+        equal_count += (size_t) _mm_cvtsi128_si32(equal_total) + (size_t) _mm_extract_epi16(equal_total, 4);
+    }
+
+    for (const char* at = first; at < begin; at++) {
+        nul_count -= !*at;
+        equal_count -= *at == '=';
+    }
+    for (const char* at = end; at < stop; at++) {
+        nul_count -= !*at;
+        equal_count -= *at == '=';
+    }
+
+    *nuls = nul_count;
+    *equals = equal_count;
+}
+#else
+static inline void easyargs_count_bytes(const char* begin, const char* end, size_t* nuls, size_t* equals) {
+    *nuls = 0;
+    *equals = 0;
+    for (const char* at = begin; at < end; at++) {
+        *nuls += !*at;
+        *equals += *at == '=';
+    }
+}
+#endif
+
+// Classify the block in one pass if its strings are contiguous. Returns 0 if they are not.
+static inline int easyargs_classify_contiguous(easyargs_tokens_t* tokens, const easyargs_filter_t* filter, char* argv[], int start) {
+    int last = tokens->end - start - 1;
+
+    // Each string must end right before the next one starts. Requiring them to start within
+    // 4 KiB of each other keeps the pass below inside pages that hold string bytes.
+    for (int i = 0; i < last; i++) {
+        const char* token = argv[start + i];
+        const char* next = argv[start + i + 1];
+        if (next <= token || next - token > 4096 || next[-1])
+            return 0;
+        tokens->lengths[i] = (size_t) (next - token) - 1;
+    }
+    tokens->lengths[last] = strlen(argv[start + last]);
+
+    size_t nuls, equals;
+    easyargs_count_bytes(argv[start], argv[start + last] + tokens->lengths[last] + 1, &nuls, &equals);
+    if (nuls != (size_t) last + 1)
+        return 0;
+
+    for (int i = 0; i <= last; i++) {
+        const char* token = argv[start + i];
+        size_t len = tokens->lengths[i];
+        easyargs_store_token(tokens, filter, i, token, len, equals ? (const char*) memchr(token, '=', len) : NULL);
+    }
+    return 1;
+}
+#endif
+
+static inline void easyargs_classify(easyargs_tokens_t* tokens, const easyargs_filter_t* filter, char* argv[], int start, int argc) {
+    tokens->start = start;
+    tokens->end = argc - start < EASYARGS_CLASSIFY_BLOCK ? argc : start + EASYARGS_CLASSIFY_BLOCK;
+
+    #ifdef EASYARGS_CONTIGUOUS_ARGV
+    if (easyargs_classify_contiguous(tokens, filter, argv, start))
+        return;
+    #endif
+
+    for (int i = start; i < tokens->end; i++) {
+        size_t len = strlen(argv[i]);
+        easyargs_store_token(tokens, filter, i - start, argv[i], len, (const char*) memchr(argv[i], '=', len));
+    }
+}
+
+
+// BUNDLED SHORT FLAGS
+// A token like -vqf sets the booleans -v, -q and -f, if every letter is the flag of one.
+// The table maps each byte to where its boolean is stored (offset or bit, plus one), or 0.
+// It is built the first time a possible bundle is seen.
+typedef struct {
+    int built;
+    unsigned int slots[256];
+} easyargs_bundle_t;
+
+#ifdef EASYARGS_PACKED_BOOLEANS
+#define EASYARGS_BOOLEAN_SLOT(name) EASYARGS_NAME(EASYARGS_BOOL_##name)
+#else
+#define EASYARGS_BOOLEAN_SLOT(name) offsetof(args_t, name)
+#endif
+
+static inline void easyargs_build_bundle(easyargs_bundle_t* bundle) {
+    memset(bundle->slots, 0, sizeof(bundle->slots));
+    bundle->built = 1;
+
+    // The first of any duplicate flags wins, as with whole tokens
+    #define BOOLEAN_ARG(name, flag, ...) \
+    if (sizeof(flag) == 3 && flag[0] == '-' && flag[1] != '-' && !bundle->slots[(unsigned char) flag[1]]) \
+        bundle->slots[(unsigned char) flag[1]] = (unsigned int) EASYARGS_BOOLEAN_SLOT(name) + 1;
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef BOOLEAN_ARG
+}
+
+// Set the booleans bundled in token, of length len. Returns 0, setting nothing, if it is not a bundle.
+static inline int easyargs_apply_bundle(easyargs_bundle_t* bundle, args_t* args, const char* token, size_t len) {
+    if (len < 3 || token[0] != '-' || token[1] == '-')
+        return 0;
+
+    if (!bundle->built)
+        easyargs_build_bundle(bundle);
+
+    for (size_t c = 1; c < len; c++) {
+        if (!bundle->slots[(unsigned char) token[c]])
+            return 0;
+    }
+
+    for (size_t c = 1; c < len; c++) {
+        unsigned int slot = bundle->slots[(unsigned char) token[c]] - 1;
+        #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+        easyargs_set_boolean_bit(args->easyargs_booleans, (int) slot);
+        #else
+        *(_Bool*) ((char*) args + slot) = 1;
+        #endif
+    }
+    return 1;
+}
+
+
+// ERROR SINK
+// parse_args_quiet records errors here instead of printing them. The caller owns the storage.
+#ifndef EASYARGS_COMMON_H
+typedef struct {
+    easyargs_status_t code;
+    int index;   // of the offending argument in argv, or -1
+    int option;  // EASYARGS_OPT_* id of the option involved, or -1
+} easyargs_error_t;
+
+typedef struct {
+    easyargs_error_t* errors;  // storage for up to capacity errors
+    int capacity;
+    int count;                 // errors reported; only the first capacity are stored
+} easyargs_errors_t;
+
+static inline void easyargs_record_error(easyargs_errors_t* errors, easyargs_status_t code, int index, int option) {
+    if (errors->count < errors->capacity) {
+        easyargs_error_t* error = &errors->errors[errors->count];
+        error->code = code;
+        error->index = index;
+        error->option = option;
+    }
+    errors->count++;
+}
+#endif
+
+// Labels of the required arguments, in order
+static const char* const easyargs_required_labels[] = {
+    #define REQUIRED_ARG(type, name, label, ...) label,
+
+    #ifdef REQUIRED_ARGS
+    REQUIRED_ARGS
+    #endif
+
+    #undef REQUIRED_ARG
+
+    NULL
+};
+
+// Pick the printf format for an error, and the argument and option name it refers to, in order
+static inline const char* easyargs_error_format(const easyargs_error_t* error, char* argv[], const char* strings[2]) {
+    const char* argument = error->index >= 0 && argv ? argv[error->index] : "";
+    const char* option = "";
+    if (error->option >= 0)
+        option = easyargs_option_flags[error->option];
+    else if (error->index >= 1 && error->index <= REQUIRED_ARG_COUNT)
+        option = easyargs_required_labels[error->index - 1];
+
+    // For flag=value, show only the value
+    if (error->option >= 0 && error->code != EASYARGS_ERR_UNKNOWN_OPTION) {
+        size_t flag_len = easyargs_option_flag_lengths[error->option];
+        if (!strncmp(argument, option, flag_len) && argument[flag_len] == '=')
+            argument += flag_len + 1;
+    }
+
+    strings[0] = argument;
+    strings[1] = option;
+    if (error->code == EASYARGS_ERR_EMPTY || error->code == EASYARGS_ERR_MISSING_VALUE || error->code == EASYARGS_ERR_TOO_MANY)
+        strings[0] = option;
+
+    switch (error->code) {
+        case EASYARGS_OK:                 return "";
+        case EASYARGS_ERR_NULL:           return "Internal error: null args or argv.";
+        case EASYARGS_ERR_EMPTY:          return "Error: empty value for '%s'.";
+        case EASYARGS_ERR_NEGATIVE:       return "Error: '%s' negative value not allowed for '%s'.";
+        case EASYARGS_ERR_SYNTAX:         return "Error: '%s' is not a valid value for '%s'.";
+        case EASYARGS_ERR_RANGE:          return "Error: '%s' is out of range for '%s'.";
+        case EASYARGS_ERR_INVALID:        return "Error: invalid value '%s' for '%s'.";
+        case EASYARGS_ERR_MISSING_ARGS:   return "Not all required arguments included.";
+        case EASYARGS_ERR_MISSING_VALUE:  return "Error: option '%s' requires a value.";
+        case EASYARGS_ERR_UNKNOWN_OPTION: return "Warning: Ignoring invalid argument '%s'";
+        case EASYARGS_ERR_UNKNOWN_COMMAND: return "Error: unknown command '%s'.";
+        case EASYARGS_ERR_READ:           return "Error: cannot read arguments.";
+        case EASYARGS_ERR_TOO_LONG:       return "Error: argument too long.";
+        case EASYARGS_ERR_NO_MEMORY:      return "Error: out of memory.";
+        case EASYARGS_ERR_TOO_MANY:       return "Error: too many values for '%s'.";
+    }
+    return "Unknown error.";
+}
+
+// Write the message for an error into buffer, like snprintf. argv must be the array that was parsed.
+// Returns the length of the full message.
+static inline int easyargs_format_error(char* buffer, size_t size, const easyargs_error_t* error, char* argv[]) {
+    const char* strings[2];
+    const char* format = easyargs_error_format(error, argv, strings);
+    return snprintf(buffer, size, format, strings[0], strings[1]);
+}
+
+// Print the message for each stored error, one per line
+static inline void easyargs_print_errors(FILE* stream, const easyargs_errors_t* errors, char* argv[]) {
+    int stored = errors->count < errors->capacity ? errors->count : errors->capacity;
+    for (int e = 0; e < stored; e++) {
+        const char* strings[2];
+        const char* format = easyargs_error_format(&errors->errors[e], argv, strings);
+        fprintf(stream, format, strings[0], strings[1]);
+        fputc('\n', stream);
+    }
+}
+
+
+// PARSER CONTEXT
+// Everything a parse keeps besides args: the flag dispatch, the filter, the bundle table, the
+// classified block of arguments, and where errors go. Nothing else is shared, so parses with a
+// context each can run on separate threads. Building the dispatch and filter takes time
+// proportional to the schema, so a context reused for many parses saves that too.
+typedef struct {
+    easyargs_dispatch_t dispatch;
+    easyargs_filter_t filter;
+    easyargs_bundle_t bundle;
+    easyargs_tokens_t tokens;
+    easyargs_errors_t* errors;  // NULL to print errors
+    void* list_buffer;          // if not NULL, holds the values of list options when they fit
+    size_t list_buffer_size;
+} easyargs_context_t;
+
+// Prepare a context whose parses print errors if errors is NULL, otherwise record them there
+static inline void easyargs_init_context(easyargs_context_t* context, easyargs_errors_t* errors) {
+    easyargs_start_profile();
+    easyargs_build_dispatch(&context->dispatch);
+    if (EASYARGS_USE_FILTER)
+        easyargs_build_filter(&context->filter);
+    context->bundle.built = 0;
+    context->errors = errors;
+    context->list_buffer = NULL;
+    context->list_buffer_size = 0;
+}
+
+
+// LIST OPTIONS
+// Before parsing, one pass over argv counts the values of each list option, so every list can
+// be placed in a single block: the context's list_buffer if given and large enough, otherwise
+// one malloc. The count may be high, e.g. for a flag given as the value of another option, but
+// never low, so appending needs no checks or reallocation. A vector option counts one value
+// more than the commas in each value given to it, and starts at a multiple of
+// EASYARGS_VECTOR_ALIGNMENT bytes from an address aligned the same way.
+
+// Whether option id is a list, array or vector
+static inline int easyargs_is_repeatable_option(int id) {
+    (void) id;
+    return 0
+        #undef EASYARGS_TYPED_LIST
+        #undef EASYARGS_TYPED_ARRAY
+        #undef EASYARGS_TYPED_VECTOR
+        #define EASYARGS_TYPED_LIST(item, list, name, ...) || id == EASYARGS_NAME(EASYARGS_OPT_##name)
+        #define EASYARGS_TYPED_ARRAY(item, capacity, name, ...) || id == EASYARGS_NAME(EASYARGS_OPT_##name)
+        #define EASYARGS_TYPED_VECTOR(item, vector, name, ...) || id == EASYARGS_NAME(EASYARGS_OPT_##name)
+        #define OPTIONAL_ARG(...)
+
+        #ifdef OPTIONAL_ARGS
+        OPTIONAL_ARGS
+        #endif
+
+        #undef OPTIONAL_ARG
+        #undef EASYARGS_TYPED_LIST
+        #undef EASYARGS_TYPED_ARRAY
+        #undef EASYARGS_TYPED_VECTOR
+        #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+        #define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+        #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+        ;
+}
+
+#ifdef EASYARGS_HAS_LISTS
+// Count and place the lists of args. Returns 0 if out of memory.
+static inline int easyargs_alloc_lists(easyargs_context_t* context, int argc, char* argv[], args_t* args) {
+    #define OPTIONAL_ARG(...)
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_VECTOR
+
+    #define EASYARGS_TYPED_LIST(item, list, name, ...) args->name.count = 0;
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, ...) args->name.count = 0;
+    OPTIONAL_ARGS
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_VECTOR
+
+    // Every flag of a list option counts, whether as flag or flag=value. A vector counts the
+    // values in the text after the '=', or else in the next argument.
+    easyargs_tokens_t* tokens = &context->tokens;
+    tokens->start = tokens->end = 0;
+    for (int i = 1 + REQUIRED_ARG_COUNT; i < argc; i++) {
+        if (i >= tokens->end)
+            easyargs_classify(tokens, &context->filter, argv, i, argc);
+        int kind = tokens->kinds[i - tokens->start];
+
+        int id = -1;
+        const char* value = i + 1 < argc ? argv[i + 1] : "";
+        if (kind & EASYARGS_TOKEN_MAY_MATCH)
+            id = easyargs_find_option(&context->dispatch, argv[i], tokens->lengths[i - tokens->start]);
+        if (id < 0 && (kind & EASYARGS_TOKEN_PREFIX_MAY_MATCH)) {
+            id = easyargs_find_option(&context->dispatch, argv[i], tokens->prefixes[i - tokens->start]);
+            value = argv[i] + tokens->prefixes[i - tokens->start] + 1;
+        }
+        (void) value; // unused without vectors
+
+        switch (id) {
+            #define EASYARGS_TYPED_LIST(item, list, name, ...) \
+            case EASYARGS_NAME(EASYARGS_OPT_##name): \
+                args->name.count++; \
+                break;
+            #define EASYARGS_TYPED_VECTOR(item, vector, name, ...) \
+            case EASYARGS_NAME(EASYARGS_OPT_##name): \
+                args->name.count += (int) easyargs_count_commas(value) + 1; \
+                break;
+            OPTIONAL_ARGS
+            #undef EASYARGS_TYPED_LIST
+            #undef EASYARGS_TYPED_VECTOR
+        }
+    }
+
+    // Each list starts at a multiple of its item size, each vector at a multiple of the alignment
+    size_t size = 0;
+    size_t alignment = 1;
+    #define EASYARGS_TYPED_LIST(item, list, name, ...) \
+    size = (size + sizeof(item) - 1) / sizeof(item) * sizeof(item) + (size_t) args->name.count * sizeof(item);
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, ...) \
+    size = (size + EASYARGS_VECTOR_ALIGNMENT - 1) / EASYARGS_VECTOR_ALIGNMENT * EASYARGS_VECTOR_ALIGNMENT + \
+        (size_t) args->name.count * sizeof(item); \
+    alignment = EASYARGS_VECTOR_ALIGNMENT;
+    OPTIONAL_ARGS
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_VECTOR
+
+    // The block starts at the first aligned byte of the buffer or allocation
+    char* block = (char*) context->list_buffer;
+    size_t skip = (size_t) (-(uintptr_t) block & (alignment - 1));
+    args->easyargs_lists = NULL;
+    if (!block || size + skip > context->list_buffer_size) {
+        block = size ? (char*) malloc(size + alignment - 1) : NULL;
+        if (size && !block)
+            return 0;
+        args->easyargs_lists = block;
+        skip = (size_t) (-(uintptr_t) block & (alignment - 1));
+    }
+    if (block)
+        block += skip;
+
+    size = 0;
+    #define EASYARGS_TYPED_LIST(item, list, name, ...) \
+    size = (size + sizeof(item) - 1) / sizeof(item) * sizeof(item); \
+    args->name.items = block ? (item*) (block + size) : NULL; \
+    size += (size_t) args->name.count * sizeof(item); \
+    args->name.count = 0;
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, ...) \
+    size = (size + EASYARGS_VECTOR_ALIGNMENT - 1) / EASYARGS_VECTOR_ALIGNMENT * EASYARGS_VECTOR_ALIGNMENT; \
+    args->name.items = block ? (item*) (block + size) : NULL; \
+    size += (size_t) args->name.count * sizeof(item); \
+    args->name.count = 0;
+    OPTIONAL_ARGS
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_VECTOR
+
+    #undef OPTIONAL_ARG
+    #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+    #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+    return 1;
+}
+#endif
+
+// Release the values of list options, if any, whether or not parsing succeeded
+static inline void free_args(args_t* args) {
+    #ifdef EASYARGS_HAS_LISTS
+    free(args->easyargs_lists);
+    args->easyargs_lists = NULL;
+    #else
+    (void) args;
+    #endif
+}
+
+// Shared by every parse_args variant
+static inline int easyargs_parse(easyargs_context_t* context, int argc, char* argv[], args_t* args) {
+    easyargs_errors_t* errors = context->errors;
+    if (!argc || !argv) {
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_NULL, -1, -1);
+        else
+            fprintf(stderr, "Internal error: null args or argv.\n");
+        return 0;
+    }
+
+    // If not enough required arguments
+    if (argc < 1 + REQUIRED_ARG_COUNT) {
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_MISSING_ARGS, -1, -1);
+        else
+            fprintf(stderr, "Not all required arguments included.\n");
+        return 0;
+    }
+
+    // Initial *ok for parsers: built-in parsers print nothing when given EASYARGS_QUIET
+    int quiet = errors ? EASYARGS_QUIET : 0;
+    int ok;
+    (void) ok; // unused when no arguments expand into code that needs it
+    (void) quiet;
+    int i = 1;
+    (void) i; // unused when there are no required arguments
+
+    // Get required arguments
+    #ifdef REQUIRED_ARGS
+    #define REQUIRED_ARG(type, name, label, description, parser) \
+    ok = quiet; \
+    args->name = (type) parser(argv[i], &ok); \
+    if (easyargs_parser_status(ok) != EASYARGS_OK) { \
+        if (errors) \
+            easyargs_record_error(errors, easyargs_parser_status(ok), i, -1); \
+        return 0; \
+    } \
+    i++;
+
+    REQUIRED_ARGS
+    #undef REQUIRED_ARG
+    #endif
+
+    #ifdef EASYARGS_HAS_LISTS
+    if (!easyargs_alloc_lists(context, argc, argv, args)) {
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_NO_MEMORY, -1, -1);
+        else
+            fprintf(stderr, "Error: out of memory.\n");
+        return 0;
+    }
+    #endif
+
+    // Get optional and boolean arguments
+    #define EASYARGS_TAKE_VALUE(name, flag) \
+        if (!value) { \
+            if (i + 1 >= argc) { \
+                if (errors) \
+                    easyargs_record_error(errors, EASYARGS_ERR_MISSING_VALUE, i, EASYARGS_NAME(EASYARGS_OPT_##name)); \
+                else \
+                    fprintf(stderr, "Error: option '%s' requires a value.\n", flag); \
+                return 0; \
+            } \
+            value = argv[++i]; \
+        } \
+        ok = quiet;
+
+    #define EASYARGS_CHECK_VALUE(name) \
+        if (easyargs_parser_status(ok) != EASYARGS_OK) { \
+            if (errors) \
+                easyargs_record_error(errors, easyargs_parser_status(ok), i, EASYARGS_NAME(EASYARGS_OPT_##name)); \
+            return 0; \
+        }
+
+    #define OPTIONAL_ARG(type, name, default, flag, label, description, formatter, parser) \
+    case EASYARGS_NAME(EASYARGS_OPT_##name): \
+        EASYARGS_TAKE_VALUE(name, flag) \
+        args->name = (type) parser(value, &ok); \
+        EASYARGS_CHECK_VALUE(name) \
+        continue;
+
+    // Lists append to the space counted for them
+    #undef EASYARGS_TYPED_LIST
+    #define EASYARGS_TYPED_LIST(item, list, name, flag, label, description, parser) \
+    case EASYARGS_NAME(EASYARGS_OPT_##name): \
+        EASYARGS_TAKE_VALUE(name, flag) \
+        args->name.items[args->name.count] = (item) parser(value, &ok); \
+        EASYARGS_CHECK_VALUE(name) \
+        args->name.count++; \
+        continue;
+
+    // Arrays append in place, up to their capacity
+    #undef EASYARGS_TYPED_ARRAY
+    #define EASYARGS_TYPED_ARRAY(item, capacity, name, flag, label, description, parser) \
+    case EASYARGS_NAME(EASYARGS_OPT_##name): \
+        EASYARGS_TAKE_VALUE(name, flag) \
+        if (args->name.count == (capacity)) { \
+            if (errors) \
+                easyargs_record_error(errors, EASYARGS_ERR_TOO_MANY, i, EASYARGS_NAME(EASYARGS_OPT_##name)); \
+            else \
+                fprintf(stderr, "Error: too many values for '%s'.\n", flag); \
+            return 0; \
+        } \
+        args->name.items[args->name.count] = (item) parser(value, &ok); \
+        EASYARGS_CHECK_VALUE(name) \
+        args->name.count++; \
+        continue;
+
+    // Vectors append all their values to the space counted for them
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, flag, label, description, parser) \
+    case EASYARGS_NAME(EASYARGS_OPT_##name): \
+        EASYARGS_TAKE_VALUE(name, flag) \
+        args->name.count += parser(value, args->name.items + args->name.count, &ok); \
+        EASYARGS_CHECK_VALUE(name) \
+        continue;
+
+    // A boolean given a value is not matched
+    #define BOOLEAN_ARG(name, flag, description) \
+    case EASYARGS_NAME(EASYARGS_OPT_##name): \
+        if (value) \
+            break; \
+        EASYARGS_SET_BOOLEAN(*args, name); \
+        continue;
+
+    easyargs_tokens_t* tokens = &context->tokens;
+    tokens->start = tokens->end = 0;
+
+    for (int i = 1 + REQUIRED_ARG_COUNT; i < argc; i++) {
+        if (i >= tokens->end)
+            easyargs_classify(tokens, &context->filter, argv, i, argc);
+        int kind = tokens->kinds[i - tokens->start];
+        size_t len = tokens->lengths[i - tokens->start];
+
+        int id = -1;
+        if (kind & EASYARGS_TOKEN_MAY_MATCH)
+            id = easyargs_find_option(&context->dispatch, argv[i], len);
+
+        // flag=value: match the part before the first '=', and parse the rest in place
+        const char* value = NULL;
+        if (id < 0 && (kind & EASYARGS_TOKEN_PREFIX_MAY_MATCH)) {
+            size_t prefix = tokens->prefixes[i - tokens->start];
+            id = easyargs_find_option(&context->dispatch, argv[i], prefix);
+            value = argv[i] + prefix + 1;
+        }
+        (void) value; // unused when there are no options
+
+        if (id < 0 && (kind & EASYARGS_TOKEN_SHAPE) == EASYARGS_TOKEN_SHORT && BOOLEAN_ARG_COUNT &&
+            easyargs_apply_bundle(&context->bundle, args, argv[i], len))
+            continue;
+
+        if (id >= 0)
+            EASYARGS_PROFILE_HIT(id);
+
+        #ifdef EASYARGS_TABLE_DRIVEN
+        if (id >= 0) {
+            const easyargs_option_t* option = &easyargs_options[id];
+
+            if (option->kind == EASYARGS_KIND_BOOLEAN && !value) {
+                #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+                easyargs_set_boolean_bit(args->easyargs_booleans, (int) option->offset);
+                #else
+                *(_Bool*) ((char*) args + option->offset) = 1;
+                #endif
+                continue;
+            }
+
+            if (option->kind != EASYARGS_KIND_BOOLEAN) {
+                char* field = (char*) args + option->offset;
+
+                if (!value) {
+                    if (i + 1 >= argc) {
+                        if (errors)
+                            easyargs_record_error(errors, EASYARGS_ERR_MISSING_VALUE, i, id);
+                        else
+                            fprintf(stderr, "Error: option '%s' requires a value.\n", option->flag);
+                        return 0;
+                    }
+                    value = argv[++i];
+                }
+                // A full array reports itself as it never calls the parser
+                ok = option->store(value, field, quiet);
+                easyargs_status_t status = ok == -(int) EASYARGS_ERR_TOO_MANY ? EASYARGS_ERR_TOO_MANY : easyargs_parser_status(ok);
+                if (status != EASYARGS_OK) {
+                    if (errors)
+                        easyargs_record_error(errors, status, i, id);
+                    else if (status == EASYARGS_ERR_TOO_MANY)
+                        fprintf(stderr, "Error: too many values for '%s'.\n", option->flag);
+                    return 0;
+                }
+                continue;
+            }
+        }
+        #else
+        switch (id) {
+            #ifdef OPTIONAL_ARGS
+            OPTIONAL_ARGS
+            #endif
+
+            #ifdef BOOLEAN_ARGS
+            BOOLEAN_ARGS
+            #endif
+        }
+        #endif
+
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_UNKNOWN_OPTION, i, -1);
+        else
+            fprintf(stderr, "Warning: Ignoring invalid argument '%s'\n", argv[i]);
+    }
+
+    #undef EASYARGS_TAKE_VALUE
+    #undef EASYARGS_CHECK_VALUE
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_ARRAY
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+    #define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+    #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+
+    return 1;
+}
+
+// Parse arguments. Returns 0 if failed.
+static inline int parse_args(int argc, char* argv[], args_t* args) {
+    easyargs_context_t context;
+    easyargs_init_context(&context, NULL);
+    return easyargs_parse(&context, argc, argv, args);
+}
+
+// Parse arguments without printing anything. Errors, and ignored arguments, are recorded in
+// errors (which may be NULL) and can be formatted later with easyargs_format_error.
+// Returns 0 if failed.
+static inline int parse_args_quiet(int argc, char* argv[], args_t* args, easyargs_errors_t* errors) {
+    easyargs_errors_t discard = { NULL, 0, 0 };
+    easyargs_context_t context;
+    easyargs_init_context(&context, errors ? errors : &discard);
+    return easyargs_parse(&context, argc, argv, args);
+}
+
+// Parse arguments with a context prepared by easyargs_init_context, which can be reused for
+// further parses but not shared by parses running at once. Returns 0 if failed.
+static inline int parse_args_with_context(easyargs_context_t* context, int argc, char* argv[], args_t* args) {
+    return easyargs_parse(context, argc, argv, args);
+}
+
+
+#ifndef EASYARGS_COMMON_H
+
+// RESPONSE FILES
+// An argument @path stands for the arguments in the file at path, separated by whitespace.
+// Single or double quotes group text containing whitespace, and a backslash outside single
+// quotes escapes the next character. Files can name further response files.
+// On POSIX systems each file is mapped privately and tokenized in place, overwriting
+// separators and quotes, so the arguments, and any char* fields parsed from them, point
+// straight into the mapping. Elsewhere the file is read into one buffer.
+// With EASYARGS_THREADS defined, large files without quotes, backslashes or nested @path
+// arguments are split by several threads at once.
+
+// Nesting limit, which also stops a file that names itself
+#ifndef EASYARGS_RESPONSE_DEPTH
+#define EASYARGS_RESPONSE_DEPTH 32
+#endif
+
+// A mapped or allocated file
+typedef struct {
+    void* data;
+    size_t size;  // size of the mapping, or 0 if data came from malloc
+} easyargs_block_t;
+
+// Expanded arguments and the memory they live in. Free with easyargs_free_response_files.
+typedef struct {
+    int argc;
+    char** argv;          // NULL-terminated, like argv
+    const char* failed;   // the @path argument that could not be read, if any
+    int threads;          // most threads splitting one file
+    size_t capacity;
+    easyargs_block_t* blocks;
+    size_t block_count;
+    size_t block_capacity;
+} easyargs_response_t;
+
+static inline int easyargs_response_push(easyargs_response_t* files, char* arg) {
+    if ((size_t) files->argc == files->capacity) {
+        size_t capacity = files->capacity ? 2 * files->capacity : 64;
+        if (capacity > INT_MAX)
+            return 0;
+        char** argv = (char**) realloc(files->argv, capacity * sizeof(char*));
+        if (!argv)
+            return 0;
+        files->argv = argv;
+        files->capacity = capacity;
+    }
+    files->argv[files->argc++] = arg;
+    return 1;
+}
+
+static inline int easyargs_response_keep(easyargs_response_t* files, void* data, size_t size) {
+    if (files->block_count == files->block_capacity) {
+        size_t capacity = files->block_capacity ? 2 * files->block_capacity : 8;
+        easyargs_block_t* blocks = (easyargs_block_t*) realloc(files->blocks, capacity * sizeof(easyargs_block_t));
+        if (!blocks)
+            return 0;
+        files->blocks = blocks;
+        files->block_capacity = capacity;
+    }
+    files->blocks[files->block_count].data = data;
+    files->blocks[files->block_count].size = size;
+    files->block_count++;
+    return 1;
+}
+
+// Get a writable copy of the file at path. Sets *slack if there is a byte to spare after it.
+static inline char* easyargs_response_read(easyargs_response_t* files, const char* path, size_t* size, int* slack) {
+    #if defined(__unix__) || defined(__APPLE__)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat info;
+    if (fstat(fd, &info) || !S_ISREG(info.st_mode) || (uintmax_t) info.st_size >= SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t) info.st_size;
+    if (!*size) {
+        close(fd);
+        *slack = 0;
+        return (char*) "";
+    }
+
+    // A private mapping is copy-on-write, so tokenizing never touches the file. The rest of the
+    // last page reads as zeros and can be written to.
+    void* data = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+    if (!easyargs_response_keep(files, data, *size)) {
+        munmap(data, *size);
+        return NULL;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    *slack = page > 0 && *size % (size_t) page != 0;
+    return (char*) data;
+    #else
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return NULL;
+    char* data = NULL;
+    long length = -1;
+    if (!fseek(file, 0, SEEK_END) && (length = ftell(file)) >= 0 && !fseek(file, 0, SEEK_SET))
+        data = (char*) malloc((size_t) length + 1);
+    if (data && fread(data, 1, (size_t) length, file) != (size_t) length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (!data)
+        return NULL;
+    if (!easyargs_response_keep(files, data, 0)) {
+        free(data);
+        return NULL;
+    }
+    *size = (size_t) length;
+    *slack = 1;
+    return data;
+    #endif
+}
+
+static inline int easyargs_response_load(easyargs_response_t* files, char* arg, int depth);
+
+// Split text in place into arguments, expanding any @path among them
+static inline int easyargs_response_split(easyargs_response_t* files, char* text, size_t size, int slack, int depth) {
+    char* end = text + size;
+    char* in = text;
+    for (;;) {
+        while (in < end && easyargs_is_space(*in))
+            in++;
+        if (in == end)
+            return 1;
+
+        // Only a bare @ names a file; a quoted or escaped one is kept
+        int nested = *in == '@';
+
+        // Plain text stays where it is. After a quote or backslash, the rest is copied down over
+        // the characters removed, so out <= in.
+        char* arg = in;
+        while (in < end && !easyargs_is_space(*in) && *in != '"' && *in != '\'' && *in != '\\')
+            in++;
+        char* out = in;
+        char quote = 0;
+        for (; in < end; in++) {
+            char c = *in;
+            if (!quote && easyargs_is_space(c))
+                break;
+            if (c == quote) {
+                quote = 0;
+                continue;
+            }
+            if (!quote && (c == '"' || c == '\'')) {
+                quote = c;
+                continue;
+            }
+            if (c == '\\' && quote != '\'' && in + 1 < end)
+                c = *++in;
+            *out++ = c;
+        }
+
+        // The last argument may end right at the end of the file, with no byte spare to terminate it
+        if (out == end && !slack) {
+            size_t length = (size_t) (out - arg);
+            char* copy = (char*) malloc(length + 1);
+            if (!copy || !easyargs_response_keep(files, copy, 0)) {
+                free(copy);
+                return 0;
+            }
+            memcpy(copy, arg, length);
+            arg = copy;
+            out = copy + length;
+        }
+        *out = '\0';
+        if (in < end)
+            in++;
+
+        if (!(nested ? easyargs_response_load(files, arg, depth + 1) : easyargs_response_push(files, arg)))
+            return 0;
+    }
+}
+
+#ifdef EASYARGS_THREADS
+// Smallest share of a file worth its own thread
+#ifndef EASYARGS_THREAD_MIN_CHUNK
+#define EASYARGS_THREAD_MIN_CHUNK (1 << 20)
+#endif
+
+#ifndef EASYARGS_MAX_THREADS
+#define EASYARGS_MAX_THREADS 64
+#endif
+
+// One thread's share of a file. It starts after a separator and ends after one, or at the end
+// of the file, so no argument crosses chunks and terminating one never writes to the next chunk.
+typedef struct {
+    char* start;
+    char* end;
+    size_t count;  // arguments in the chunk
+    int plain;     // no quotes, backslashes or @path
+    char** argv;   // where its arguments go
+} easyargs_chunk_t;
+
+// First pass: count the arguments, and check that the plain split will do. An argument starts
+// at each non-space after a space; the byte before a chunk is always a space.
+#if EASYARGS_SIMD_WIDTH
+static inline __m128i easyargs_space_mask(__m128i bytes) {
+    __m128i controls = _mm_subs_epu8(_mm_sub_epi8(bytes, _mm_set1_epi8('\t')), _mm_set1_epi8('\r' - '\t'));
+    return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(controls, _mm_setzero_si128()));
+}
+
+static inline void* easyargs_count_chunk(void* data) {
+    easyargs_chunk_t* chunk = (easyargs_chunk_t*) data;
+    const char* text = chunk->start;
+    size_t size = (size_t) (chunk->end - chunk->start);
+    size_t count = size && !easyargs_is_space(text[0]);
+    int special = size && (text[0] == '"' || text[0] == '\'' || text[0] == '\\' || text[0] == '@');
+
+    // Compare each 16 bytes with the 16 before them shifted by one, keeping per-byte counts
+    // for up to 255 blocks at a time
+    const __m128i zero = _mm_setzero_si128();
+    __m128i specials = zero;
+    size_t i = 1;
+    while (i + 16 <= size) {
+        size_t blocks = (size - i) / 16;
+        if (blocks > 255)
+            blocks = 255;
+        __m128i sums = zero;
+        for (size_t b = 0; b < blocks; b++, i += 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*) (text + i));
+            __m128i before = easyargs_space_mask(_mm_loadu_si128((const __m128i*) (text + i - 1)));
+            sums = _mm_sub_epi8(sums, _mm_andnot_si128(easyargs_space_mask(bytes), before));
+            specials = _mm_or_si128(specials, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')));
+            specials = _mm_or_si128(specials, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')));
+            specials = _mm_or_si128(specials, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+            specials = _mm_or_si128(specials, _mm_and_si128(before, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('@'))));
+        }
+        __m128i total = _mm_sad_epu8(sums, zero);
+        count += (size_t) _mm_cvtsi128_si32(total) + (size_t) _mm_extract_epi16(total, 4);
     }
+    special |= _mm_movemask_epi8(specials);
+
+    for (; i < size; i++) {
+        char c = text[i];
+        int start = easyargs_is_space(text[i - 1]) && !easyargs_is_space(c);
+        count += start;
+        special |= c == '"' || c == '\'' || c == '\\' || (start && c == '@');
+    }
+    chunk->count = count;
+    chunk->plain = !special;
+    return NULL;
+}
+#else
+static inline void* easyargs_count_chunk(void* data) {
+    easyargs_chunk_t* chunk = (easyargs_chunk_t*) data;
+    size_t count = 0;
+    int special = 0;
+    int space = 1;
+    for (const char* at = chunk->start; at < chunk->end; at++) {
+        int start = space && !easyargs_is_space(*at);
+        count += start;
+        special |= *at == '"' || *at == '\'' || *at == '\\' || (start && *at == '@');
+        space = easyargs_is_space(*at);
+    }
+    chunk->count = count;
+    chunk->plain = !special;
+    return NULL;
+}
+#endif
+
+// Second pass: terminate the arguments in place and store them in order
+static inline void* easyargs_split_chunk(void* data) {
+    easyargs_chunk_t* chunk = (easyargs_chunk_t*) data;
+    char** out = chunk->argv;
+    char* in = chunk->start;
+    char* end = chunk->end;
+    for (;;) {
+        while (in < end && easyargs_is_space(*in))
+            in++;
+        if (in == end)
+            break;
+        *out++ = in;
+        while (in < end && !easyargs_is_space(*in))
+            in++;
+        if (in == end)
+            break;  // the last argument in the file, terminated by the caller
+        *in++ = '\0';
+    }
+    return NULL;
+}
+
+// Run job on every chunk, one thread each, with the calling thread taking the first
+static inline void easyargs_run_chunks(void* (*job)(void*), easyargs_chunk_t* chunks, int count) {
+    pthread_t threads[EASYARGS_MAX_THREADS];
+    int started[EASYARGS_MAX_THREADS];
+    for (int i = 1; i < count; i++)
+        started[i] = !pthread_create(&threads[i], NULL, job, &chunks[i]);
+    job(&chunks[0]);
+    for (int i = 1; i < count; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            job(&chunks[i]);
+    }
+}
+
+// Split a large file across threads. Counting first sizes argv exactly, so each thread stores
+// its arguments straight into place, keeping their order.
+static inline int easyargs_response_split_parallel(easyargs_response_t* files, char* text, size_t size, int slack, int depth) {
+    size_t pieces = size / EASYARGS_THREAD_MIN_CHUNK;
+    int count = files->threads < EASYARGS_MAX_THREADS ? files->threads : EASYARGS_MAX_THREADS;
+    if ((size_t) count > pieces)
+        count = (int) pieces;
+    if (count < 2)
+        return easyargs_response_split(files, text, size, slack, depth);
+
+    easyargs_chunk_t chunks[EASYARGS_MAX_THREADS];
+    char* end = text + size;
+    char* start = text;
+    for (int i = 0; i < count; i++) {
+        char* stop = i == count - 1 ? end : text + size / (size_t) count * (size_t) (i + 1);
+        if (stop < start)
+            stop = start;
+        while (stop < end && !easyargs_is_space(*stop))
+            stop++;
+        if (stop < end)
+            stop++;
+        chunks[i].start = start;
+        chunks[i].end = stop;
+        start = stop;
+    }
+
+    // Nothing has been written yet, so a file needing the full tokenizer can still have it
+    easyargs_run_chunks(easyargs_count_chunk, chunks, count);
+    size_t total = 0;
+    for (int i = 0; i < count; i++) {
+        if (!chunks[i].plain)
+            return easyargs_response_split(files, text, size, slack, depth);
+        total += chunks[i].count;
+    }
+    if (!total)
+        return 1;
+
+    if (total >= (size_t) INT_MAX - (size_t) files->argc)
+        return 0;
+    size_t needed = (size_t) files->argc + total;
+    if (needed > files->capacity) {
+        char** argv = (char**) realloc(files->argv, needed * sizeof(char*));
+        if (!argv)
+            return 0;
+        files->argv = argv;
+        files->capacity = needed;
+    }
+    char** out = files->argv + files->argc;
+    for (int i = 0; i < count; i++) {
+        chunks[i].argv = out;
+        out += chunks[i].count;
+    }
+    easyargs_run_chunks(easyargs_split_chunk, chunks, count);
+    files->argc += (int) total;
+
+    // The last argument may end right at the end of the file, with no byte spare to terminate it
+    if (!easyargs_is_space(end[-1])) {
+        if (!slack) {
+            char* arg = files->argv[files->argc - 1];
+            size_t length = (size_t) (end - arg);
+            char* copy = (char*) malloc(length + 1);
+            if (!copy || !easyargs_response_keep(files, copy, 0)) {
+                free(copy);
+                return 0;
+            }
+            memcpy(copy, arg, length);
+            files->argv[files->argc - 1] = copy;
+            end = copy + length;
+        }
+        *end = '\0';
+    }
+    return 1;
+}
+#endif
+
+static inline int easyargs_response_load(easyargs_response_t* files, char* arg, int depth) {
+    size_t size;
+    int slack;
+    char* text = depth <= EASYARGS_RESPONSE_DEPTH ? easyargs_response_read(files, arg + 1, &size, &slack) : NULL;
+    #ifdef EASYARGS_THREADS
+    int ok = text && easyargs_response_split_parallel(files, text, size, slack, depth);
+    #else
+    int ok = text && easyargs_response_split(files, text, size, slack, depth);
+    #endif
+    if (!ok) {
+        if (!files->failed)
+            files->failed = arg;
+        return 0;
+    }
+    return 1;
+}
+
+// Expand every @path argument in argv, splitting each file with up to threads threads if
+// EASYARGS_THREADS is defined. Returns 0 if a file could not be read, naming it in
+// files->failed. Either way, call easyargs_free_response_files once done with the arguments.
+static inline int easyargs_expand_response_files_parallel(int argc, char* argv[], easyargs_response_t* files, int threads) {
+    memset(files, 0, sizeof(*files));
+    files->threads = threads;
+    for (int i = 0; i < argc; i++) {
+        int ok = i > 0 && argv[i][0] == '@' ? easyargs_response_load(files, argv[i], 1) : easyargs_response_push(files, argv[i]);
+        if (!ok)
+            return 0;
+    }
+    if (!easyargs_response_push(files, NULL))
+        return 0;
+    files->argc--;
+    return 1;
+}
+
+// Expand every @path argument in argv, as above, on the calling thread
+static inline int easyargs_expand_response_files(int argc, char* argv[], easyargs_response_t* files) {
+    return easyargs_expand_response_files_parallel(argc, argv, files, 1);
+}
+
+static inline void easyargs_free_response_files(easyargs_response_t* files) {
+    for (size_t i = 0; i < files->block_count; i++) {
+        #if defined(__unix__) || defined(__APPLE__)
+        if (files->blocks[i].size) {
+            munmap(files->blocks[i].data, files->blocks[i].size);
+            continue;
+        }
+        #endif
+        free(files->blocks[i].data);
+    }
+    free(files->blocks);
+    free(files->argv);
+    memset(files, 0, sizeof(*files));
+}
+
+#endif
+
+
+// STREAMING
+// Arguments can also be read from a file descriptor, e.g. a pipe carrying millions of file
+// names, through a fixed buffer of EASYARGS_STREAM_BUFFER bytes. They are separated by
+// whitespace, without quoting. Arguments that are not options are handed to a callback in
+// chunks instead of being kept, so memory use does not grow with their number. So are the
+// values of list and array options, with the option's id. The text of required arguments and option
+// values is copied, one buffer per argument, so char* fields stay valid until easyargs_free_stream.
+
+#ifndef EASYARGS_COMMON_H
+#ifndef EASYARGS_STREAM_BUFFER
+#define EASYARGS_STREAM_BUFFER 65536
+#endif
+
+// Most values handed to the callback at once
+#ifndef EASYARGS_STREAM_CHUNK
+#define EASYARGS_STREAM_CHUNK 1024
+#endif
+
+// Receives count values, valid only during the call. option is -1 for arguments that are not options.
+typedef void (*easyargs_values_fn)(void* context, int option, char* const* values, size_t count);
+#endif
+
+// Required argument ids, in declaration order
+enum {
+    #define REQUIRED_ARG(type, name, ...) EASYARGS_NAME(EASYARGS_REQ_##name),
+
+    #ifdef REQUIRED_ARGS
+    REQUIRED_ARGS
+    #endif
+
+    #undef REQUIRED_ARG
+
+    EASYARGS_REQUIRED_COUNT
+};
+
+typedef struct {
+    args_t* args;
+    easyargs_errors_t* errors;     // NULL to print errors
+    easyargs_values_fn on_values;  // NULL to ignore arguments that are not options, with a warning
+    void* context;
+    int index;          // of the next argument, counting as in argv
+    int pending;        // option waiting for its value, or -1
+    int pending_index;  // index of its flag
+    int failed;         // an error ended parsing
+    easyargs_dispatch_t dispatch;
+    easyargs_bundle_t bundle;
+    char* values[EASYARGS_STREAM_CHUNK];
+    size_t value_count;
+    char* copies[EASYARGS_REQUIRED_COUNT + EASYARGS_OPTION_COUNT + 1];  // required arguments, then option values
+    size_t copy_sizes[EASYARGS_REQUIRED_COUNT + EASYARGS_OPTION_COUNT + 1];
+} easyargs_stream_t;
+
+// Parse text as required argument number index
+static inline int easyargs_store_required(args_t* args, int index, const char* text, int quiet) {
+    int ok = quiet;
+    (void) args;
+    (void) text;
+    switch (index) {
+        #define REQUIRED_ARG(type, name, label, description, parser) \
+        case EASYARGS_NAME(EASYARGS_REQ_##name): \
+            args->name = (type) parser(text, &ok); \
+            break;
+
+        #ifdef REQUIRED_ARGS
+        REQUIRED_ARGS
+        #endif
+
+        #undef REQUIRED_ARG
+    }
+    return ok;
+}
+
+// Parse text as the value of option id
+static inline int easyargs_store_value(args_t* args, int id, const char* text, int quiet) {
+    #ifdef EASYARGS_TABLE_DRIVEN
+    return easyargs_options[id].store(text, (char*) args + easyargs_options[id].offset, quiet);
+    #else
+    int ok = quiet;
+    (void) args;
+    (void) text;
+    switch (id) {
+        #define OPTIONAL_ARG(type, name, default, flag, label, description, formatter, parser) \
+        case EASYARGS_NAME(EASYARGS_OPT_##name): \
+            args->name = (type) parser(text, &ok); \
+            break;
+
+        // Values of lists, arrays and vectors go to the callback instead
+        #undef EASYARGS_TYPED_LIST
+        #undef EASYARGS_TYPED_ARRAY
+        #undef EASYARGS_TYPED_VECTOR
+        #define EASYARGS_TYPED_LIST(...)
+        #define EASYARGS_TYPED_ARRAY(...)
+        #define EASYARGS_TYPED_VECTOR(...)
 
-    for (int i = 1 + REQUIRED_ARG_COUNT; i < argc; i++) {
         #ifdef OPTIONAL_ARGS
         OPTIONAL_ARGS
         #endif
 
+        #undef OPTIONAL_ARG
+        #undef EASYARGS_TYPED_LIST
+        #undef EASYARGS_TYPED_ARRAY
+        #undef EASYARGS_TYPED_VECTOR
+        #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+        #define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+        #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
+    }
+    return ok;
+    #endif
+}
+
+// Set boolean option id
+static inline void easyargs_store_boolean(args_t* args, int id) {
+    #ifdef EASYARGS_TABLE_DRIVEN
+    #if defined(EASYARGS_PACKED_BOOLEANS) && defined(BOOLEAN_ARGS)
+    easyargs_set_boolean_bit(args->easyargs_booleans, (int) easyargs_options[id].offset);
+    #else
+    *(_Bool*) ((char*) args + easyargs_options[id].offset) = 1;
+    #endif
+    #else
+    (void) args;
+    switch (id) {
+        #define BOOLEAN_ARG(name, flag, description) \
+        case EASYARGS_NAME(EASYARGS_OPT_##name): \
+            EASYARGS_SET_BOOLEAN(*args, name); \
+            break;
+
         #ifdef BOOLEAN_ARGS
         BOOLEAN_ARGS
         #endif
 
-        fprintf(stderr, "Warning: Ignoring invalid argument '%s'\n", argv[i]);
+        #undef BOOLEAN_ARG
     }
+    #endif
+}
 
-    #undef OPTIONAL_ARG
-    #undef BOOLEAN_ARG
+static inline void easyargs_start_stream(easyargs_stream_t* stream, args_t* args, easyargs_values_fn on_values, void* context, easyargs_errors_t* errors) {
+    memset(stream, 0, sizeof(*stream));
+    stream->args = args;
+    stream->errors = errors;
+    stream->on_values = on_values;
+    stream->context = context;
+    stream->index = 1;
+    stream->pending = -1;
+    easyargs_start_profile();
+    easyargs_build_dispatch(&stream->dispatch);
+}
+
+// Free the copies that char* fields may point to
+static inline void easyargs_free_stream(easyargs_stream_t* stream) {
+    for (int slot = 0; slot < EASYARGS_REQUIRED_COUNT + EASYARGS_OPTION_COUNT; slot++) {
+        free(stream->copies[slot]);
+        stream->copies[slot] = NULL;
+        stream->copy_sizes[slot] = 0;
+    }
+}
 
+// Pass the values gathered so far to the callback
+static inline void easyargs_flush_stream(easyargs_stream_t* stream) {
+    if (stream->value_count)
+        stream->on_values(stream->context, -1, stream->values, stream->value_count);
+    stream->value_count = 0;
+}
+
+// Report an error found by the stream itself; parsers report their own when printing
+static inline void easyargs_stream_error(easyargs_stream_t* stream, easyargs_status_t code, int index, int option, const char* text) {
+    if (stream->errors) {
+        easyargs_record_error(stream->errors, code, index, option);
+        return;
+    }
+
+    easyargs_error_t error = { code, -1, option };
+    const char* strings[2];
+    const char* format = easyargs_error_format(&error, NULL, strings);
+    if (code == EASYARGS_ERR_UNKNOWN_OPTION)
+        strings[0] = text;
+    fprintf(stderr, format, strings[0], strings[1]);
+    fputc('\n', stderr);
+}
+
+// Keep a copy of text, of length len, in the given slot
+static inline char* easyargs_stream_copy(easyargs_stream_t* stream, int slot, const char* text, size_t len) {
+    if (stream->copy_sizes[slot] <= len) {
+        char* copy = (char*) realloc(stream->copies[slot], len + 1);
+        if (!copy)
+            return NULL;
+        stream->copies[slot] = copy;
+        stream->copy_sizes[slot] = len + 1;
+    }
+    memcpy(stream->copies[slot], text, len);
+    stream->copies[slot][len] = '\0';
+    return stream->copies[slot];
+}
+
+// Handle the next argument, NUL-terminated and len bytes long. It need only stay valid until the
+// next flush. Returns 0 on an error that ends parsing, as parse_args would.
+static inline int easyargs_stream_token(easyargs_stream_t* stream, char* token, size_t len) {
+    int index = stream->index++;
+    int quiet = stream->errors ? EASYARGS_QUIET : 0;
+
+    if (index <= EASYARGS_REQUIRED_COUNT) {
+        char* text = easyargs_stream_copy(stream, index - 1, token, len);
+        int status = text ? easyargs_parser_status(easyargs_store_required(stream->args, index - 1, text, quiet)) : EASYARGS_ERR_READ;
+        if (status != EASYARGS_OK) {
+            if (stream->errors || status == EASYARGS_ERR_READ)
+                easyargs_stream_error(stream, (easyargs_status_t) status, index, -1, token);
+            return 0;
+        }
+        return 1;
+    }
+
+    int id = stream->pending;
+    char* value = NULL;
+    size_t value_len = len;
+    if (id >= 0) {
+        stream->pending = -1;
+        value = token;
+    } else {
+        id = easyargs_find_option(&stream->dispatch, token, len);
+
+        char* equals = id < 0 ? (char*) memchr(token, '=', len) : NULL;
+        if (equals) {
+            id = easyargs_find_option(&stream->dispatch, token, (size_t) (equals - token));
+            value = equals + 1;
+            value_len = len - (size_t) (equals - token) - 1;
+        }
+
+        if (id < 0 && BOOLEAN_ARG_COUNT && easyargs_apply_bundle(&stream->bundle, stream->args, token, len))
+            return 1;
+        if (id >= 0)
+            EASYARGS_PROFILE_HIT(id);
+
+        // A boolean given a value is not matched
+        if (id >= OPTIONAL_ARG_COUNT && !value) {
+            easyargs_store_boolean(stream->args, id);
+            return 1;
+        }
+        if (id < 0 || id >= OPTIONAL_ARG_COUNT) {
+            if (!stream->on_values) {
+                easyargs_stream_error(stream, EASYARGS_ERR_UNKNOWN_OPTION, index, -1, token);
+                return 1;
+            }
+            stream->values[stream->value_count++] = token;
+            if (stream->value_count == EASYARGS_STREAM_CHUNK)
+                easyargs_flush_stream(stream);
+            return 1;
+        }
+        if (!value) {
+            stream->pending = id;
+            stream->pending_index = index;
+            return 1;
+        }
+    }
+
+    // Nothing is counted ahead in a stream, and each value would need its own copy, so values of
+    // lists and arrays are handed to the callback as they come
+    if (easyargs_is_repeatable_option(id)) {
+        easyargs_flush_stream(stream);
+        if (!stream->on_values) {
+            easyargs_stream_error(stream, EASYARGS_ERR_UNKNOWN_OPTION, index, -1, token);
+            return 1;
+        }
+        stream->on_values(stream->context, id, &value, 1);
+        return 1;
+    }
+
+    char* text = easyargs_stream_copy(stream, EASYARGS_REQUIRED_COUNT + id, value, value_len);
+    int status = text ? easyargs_parser_status(easyargs_store_value(stream->args, id, text, quiet)) : EASYARGS_ERR_READ;
+    if (status != EASYARGS_OK) {
+        if (stream->errors || status == EASYARGS_ERR_READ)
+            easyargs_stream_error(stream, (easyargs_status_t) status, index, id, token);
+        return 0;
+    }
     return 1;
 }
 
+// Push parsing: after easyargs_start_stream, hand over arguments one at a time as they arrive,
+// e.g. from network frames, then call easyargs_finish. Nothing is rescanned: the stream
+// remembers an option still waiting for its value and the required arguments seen so far.
+// The token need only stay valid during the call, and may be passed to on_values as it is, like
+// an argument in argv. Returns 0 once an error has ended parsing; later arguments are then ignored.
+static inline int easyargs_feed(easyargs_stream_t* stream, char* token) {
+    if (stream->failed)
+        return 0;
+    stream->failed = !easyargs_stream_token(stream, token, strlen(token));
+    easyargs_flush_stream(stream);
+    return !stream->failed;
+}
+
+// Check that nothing is missing once all arguments are in. Returns 0 if failed.
+static inline int easyargs_finish(easyargs_stream_t* stream) {
+    easyargs_flush_stream(stream);
+    if (stream->failed)
+        return 0;
+    if (stream->index <= EASYARGS_REQUIRED_COUNT) {
+        easyargs_stream_error(stream, EASYARGS_ERR_MISSING_ARGS, -1, -1, NULL);
+        return 0;
+    }
+    if (stream->pending >= 0) {
+        easyargs_stream_error(stream, EASYARGS_ERR_MISSING_VALUE, stream->pending_index, stream->pending, NULL);
+        return 0;
+    }
+    return 1;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Parse the arguments read from fd until end of file, as parse_args would parse argv[1] onwards.
+// Arguments that are not options go to on_values, if not NULL. Errors are printed if errors is
+// NULL, otherwise recorded, with indexes counting the arguments read from 1. Returns 0 if failed.
+// Either way, call easyargs_free_stream once done with args.
+static inline int easyargs_parse_fd(easyargs_stream_t* stream, int fd, args_t* args, easyargs_values_fn on_values, void* context, easyargs_errors_t* errors) {
+    easyargs_start_stream(stream, args, on_values, context, errors);
+    char* buffer = (char*) malloc(EASYARGS_STREAM_BUFFER);
+    if (!buffer) {
+        easyargs_stream_error(stream, EASYARGS_ERR_READ, -1, -1, NULL);
+        return 0;
+    }
+
+    // Arguments are split in place. One cut off by the end of the buffer moves to the start.
+    size_t kept = 0;
+    for (int eof = 0; !eof;) {
+        if (kept == EASYARGS_STREAM_BUFFER) {
+            easyargs_stream_error(stream, EASYARGS_ERR_TOO_LONG, stream->index, -1, NULL);
+            free(buffer);
+            return 0;
+        }
+
+        ssize_t got = read(fd, buffer + kept, EASYARGS_STREAM_BUFFER - kept);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0) {
+            easyargs_stream_error(stream, EASYARGS_ERR_READ, -1, -1, NULL);
+            free(buffer);
+            return 0;
+        }
+        eof = got == 0;
+
+        size_t end = kept + (size_t) got;
+        size_t start = 0;
+        for (;;) {
+            while (start < end && easyargs_is_space(buffer[start]))
+                start++;
+            size_t stop = start;
+            while (stop < end && !easyargs_is_space(buffer[stop]))
+                stop++;
+            if (start >= end || (stop == end && (!eof || stop == EASYARGS_STREAM_BUFFER)))
+                break;
+
+            buffer[stop] = '\0';
+            if (!easyargs_stream_token(stream, buffer + start, stop - start)) {
+                free(buffer);
+                return 0;
+            }
+            start = stop + 1;
+        }
+
+        easyargs_flush_stream(stream);
+        kept = start < end ? end - start : 0;
+        memmove(buffer, buffer + end - kept, kept);
+    }
+
+    free(buffer);
+    return easyargs_finish(stream);
+}
+#endif
+
+
+// HELP TEXT
+// Width of the widest label column entry, plus one. Computed at compile time as the size of
+// a union holding one char array per argument.
+enum {
+    EASYARGS_HELP_WIDTH = (int) sizeof(union {
+        char easyargs_min_width[1];
+
+        #define REQUIRED_ARG(type, name, label, ...) char name[sizeof(label) + 2];
+        #define OPTIONAL_ARG(type, name, default, flag, label, ...) char name[sizeof(flag) + sizeof(label) + 2];
+        #define BOOLEAN_ARG(name, flag, ...) char name[sizeof(flag)];
+
+        #ifdef REQUIRED_ARGS
+        REQUIRED_ARGS
+        #endif
+
+        #ifdef OPTIONAL_ARGS
+        OPTIONAL_ARGS
+        #endif
+
+        #ifdef BOOLEAN_ARGS
+        BOOLEAN_ARGS
+        #endif
+
+        #undef REQUIRED_ARG
+        #undef OPTIONAL_ARG
+        #undef BOOLEAN_ARG
+    }) - 1
+};
+
+// Usual size of the help text, excluding the command name: the fixed text of each line, padding,
+// and room for a default value. Only an estimate, as defaults are formatted at runtime.
+enum {
+    EASYARGS_HELP_SIZE = 64
+        #define REQUIRED_ARG(type, name, label, description, ...) + 2 * sizeof(label) + sizeof(description) + EASYARGS_HELP_WIDTH + 16
+        #define OPTIONAL_ARG(type, name, default, flag, label, description, ...) + 2 * sizeof(flag) + 2 * sizeof(label) + sizeof(description) + EASYARGS_HELP_WIDTH + 48
+        #define BOOLEAN_ARG(name, flag, description) + 2 * sizeof(flag) + sizeof(description) + EASYARGS_HELP_WIDTH + 16
+
+        #ifdef REQUIRED_ARGS
+        REQUIRED_ARGS
+        #endif
+
+        #ifdef OPTIONAL_ARGS
+        OPTIONAL_ARGS
+        #endif
+
+        #ifdef BOOLEAN_ARGS
+        BOOLEAN_ARGS
+        #endif
+
+        #undef REQUIRED_ARG
+        #undef OPTIONAL_ARG
+        #undef BOOLEAN_ARG
+};
+
+// Write the help text into buffer, like snprintf, given command used to launch program.
+// Returns the length of the full text.
+static inline int easyargs_format_help(char* buffer, size_t size, const char* exec_alias) {
+    easyargs_text_t text = { buffer, size, 0 };
+    if (size)
+        buffer[0] = '\0';
 
-// Display help string, given command used to launch program, e.g., argv[0]
-static inline void print_help(char* exec_alias) {
     // USAGE SECTION
-    printf("USAGE:\n");
-    printf("    %s ", exec_alias);
+    easyargs_appendf(&text, "USAGE:\n    %s ", exec_alias);
 
     #ifdef REQUIRED_ARGS
     if (REQUIRED_ARG_COUNT > 0 && REQUIRED_ARG_COUNT <= 3) {
         #define REQUIRED_ARG(type, name, label, ...) "<" label "> "
-        printf(REQUIRED_ARGS);
+        easyargs_appendf(&text, REQUIRED_ARGS);
         #undef REQUIRED_ARG
     } else {
-        printf("<ARGUMENTS> ");
+        easyargs_appendf(&text, "<ARGUMENTS> ");
     }
     #endif
 
     if (OPTIONAL_ARG_COUNT + BOOLEAN_ARG_COUNT <= 3) {
+        // One call per option, so no string grows with the schema
         #ifdef OPTIONAL_ARGS
-        #define OPTIONAL_ARG(type, name, default, flag, label, ...) "[" flag " <" label ">" "] "
-        printf(OPTIONAL_ARGS);
+        #define OPTIONAL_ARG(type, name, default, flag, label, ...) easyargs_appendf(&text, "[" flag " <" label ">" "] ");
+        OPTIONAL_ARGS
         #undef OPTIONAL_ARG
         #endif
 
         #ifdef BOOLEAN_ARGS
-        #define BOOLEAN_ARG(name, flag, ...) "[" flag "] "
-        printf(BOOLEAN_ARGS);
+        #define BOOLEAN_ARG(name, flag, ...) easyargs_appendf(&text, "[" flag "] ");
+        BOOLEAN_ARGS
         #undef BOOLEAN_ARG
         #endif
     } else {
-        printf("[OPTIONS]");
+        easyargs_appendf(&text, "[OPTIONS]");
     }
 
-    printf("\n\n");
-
-    // Get maximum width of labels for spacing
-    int max_width = 0;
-    (void) max_width; // suppress unused variable warning
-    #ifdef REQUIRED_ARGS
-    #define REQUIRED_ARG(type, name, label, ...) \
-        { int len = strlen(label) + 2; if (len > max_width) max_width = len; }
-    REQUIRED_ARGS
-    #undef REQUIRED_ARG
-    #endif
-
-    #ifdef OPTIONAL_ARGS
-    #define OPTIONAL_ARG(type, name, default, flag, label, ...) \
-        { int len = strlen(flag) + 1 + strlen(label) + 2; if (len > max_width) max_width = len; }
-    OPTIONAL_ARGS
-    #undef OPTIONAL_ARG
-    #endif
-
-    #ifdef BOOLEAN_ARGS
-    #define BOOLEAN_ARG(name, flag, ...) \
-        { int len = strlen(flag); if (len > max_width) max_width = len; }
-    BOOLEAN_ARGS
-    #undef BOOLEAN_ARG
-    #endif
+    easyargs_appendf(&text, "\n\n");
 
     // ARGUMENTS SECTION
     #ifdef REQUIRED_ARGS
-    printf("ARGUMENTS:\n");
+    easyargs_appendf(&text, "ARGUMENTS:\n");
 
     #define REQUIRED_ARG(type, name, label, description, ...) \
-        printf("    <" label ">%*s    " description "\n", max_width - (int)strlen(label) - 2, "");
+        easyargs_appendf(&text, "    <" label ">%*s    " description "\n", EASYARGS_HELP_WIDTH - (int) sizeof(label) - 1, "");
     REQUIRED_ARGS
     #undef REQUIRED_ARG
 
-    printf("\n");
+    easyargs_appendf(&text, "\n");
     #endif
 
     #if defined(OPTIONAL_ARGS) || defined(BOOLEAN_ARGS)
-    printf("OPTIONS:\n");
+    easyargs_appendf(&text, "OPTIONS:\n");
+
+    #ifdef EASYARGS_TABLE_DRIVEN
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++) {
+        const easyargs_option_t* option = &easyargs_options[id];
+        if (option->kind == EASYARGS_KIND_BOOLEAN) {
+            easyargs_appendf(&text, "    %s%*s    %s\n", option->flag, EASYARGS_HELP_WIDTH - option->flag_len, "", option->description);
+            continue;
+        }
+        if (option->kind == EASYARGS_KIND_LIST) {
+            easyargs_appendf(&text, "    %s <%s>%*s    %s (repeatable", option->flag, option->label, EASYARGS_HELP_WIDTH - option->label_len - option->flag_len - 3, "", option->description);
+            if (option->append_default)
+                option->append_default(&text);
+            easyargs_appendf(&text, ")\n");
+            continue;
+        }
+
+        easyargs_appendf(&text, "    %s <%s>%*s    %s (default: ", option->flag, option->label, EASYARGS_HELP_WIDTH - option->label_len - option->flag_len - 3, "", option->description);
+        option->append_default(&text);
+        easyargs_appendf(&text, ")\n");
+    }
+    #else
 
     #ifdef OPTIONAL_ARGS
-
     #define OPTIONAL_ARG(type, name, default, flag, label, description, formatter, ...) \
-        printf("    " flag " <" label ">%*s    " description " (default: " formatter ")\n", max_width - (int)strlen(label) - (int)strlen(flag) - 3, "", default);
+        easyargs_appendf(&text, "    " flag " <" label ">%*s    " description " (default: " formatter ")\n", EASYARGS_HELP_WIDTH - (int) sizeof(label) - (int) sizeof(flag) - 1, "", default);
+    #undef EASYARGS_TYPED_LIST
+    #define EASYARGS_TYPED_LIST(item, list, name, flag, label, description, ...) \
+        easyargs_appendf(&text, "    " flag " <" label ">%*s    " description " (repeatable)\n", EASYARGS_HELP_WIDTH - (int) sizeof(label) - (int) sizeof(flag) - 1, "");
+    #undef EASYARGS_TYPED_ARRAY
+    #define EASYARGS_TYPED_ARRAY(item, capacity, name, flag, label, description, ...) \
+        easyargs_appendf(&text, "    " flag " <" label ">%*s    " description " (repeatable, at most %d)\n", EASYARGS_HELP_WIDTH - (int) sizeof(label) - (int) sizeof(flag) - 1, "", (int) (capacity));
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_VECTOR(item, vector, name, flag, label, description, ...) \
+        easyargs_appendf(&text, "    " flag " <" label ">%*s    " description " (repeatable, comma-separated)\n", EASYARGS_HELP_WIDTH - (int) sizeof(label) - (int) sizeof(flag) - 1, "");
     OPTIONAL_ARGS
     #undef OPTIONAL_ARG
+    #undef EASYARGS_TYPED_LIST
+    #undef EASYARGS_TYPED_ARRAY
+    #undef EASYARGS_TYPED_VECTOR
+    #define EASYARGS_TYPED_LIST EASYARGS_LIST_AS_OPTIONAL
+    #define EASYARGS_TYPED_ARRAY EASYARGS_ARRAY_AS_OPTIONAL
+    #define EASYARGS_TYPED_VECTOR EASYARGS_VECTOR_AS_OPTIONAL
     #endif
 
     #ifdef BOOLEAN_ARGS
     #define BOOLEAN_ARG(name, flag, description) \
-        printf("    " flag "%*s    " description "\n", max_width - (int)strlen(flag), "");
+        easyargs_appendf(&text, "    " flag "%*s    " description "\n", EASYARGS_HELP_WIDTH - (int) sizeof(flag) + 1, "");
     BOOLEAN_ARGS
     #undef BOOLEAN_ARG
     #endif
 
     #endif
+
+    #endif
+
+    return (int) text.length;
+}
+
+// Build the help text in a buffer allocated with malloc, e.g. to cache it. Returns NULL if failed.
+// The text is NUL-terminated, and its length is stored in *length if length is not NULL.
+static inline char* easyargs_help_text(const char* exec_alias, size_t* length) {
+    // Sized from the estimate, so the text is normally formatted only once
+    size_t size = EASYARGS_HELP_SIZE + strlen(exec_alias);
+    char* buffer = (char*) malloc(size);
+    if (!buffer)
+        return NULL;
+
+    int needed = easyargs_format_help(buffer, size, exec_alias);
+    if (needed >= 0 && (size_t) needed >= size) {
+        free(buffer);
+        size = (size_t) needed + 1;
+        buffer = (char*) malloc(size);
+        if (!buffer)
+            return NULL;
+        needed = easyargs_format_help(buffer, size, exec_alias);
+    }
+    if (needed < 0) {
+        free(buffer);
+        return NULL;
+    }
+
+    if (length)
+        *length = (size_t) needed;
+    return buffer;
+}
+
+// Format the help text into a stack buffer, or a heap buffer if it may not fit.
+// Calls emit(context, text, length) once. Returns 0 if failed.
+static inline int easyargs_emit_help(const char* exec_alias, int (*emit)(void* context, const char* text, size_t length), void* context) {
+    char local[4096];
+    if (EASYARGS_HELP_SIZE + strlen(exec_alias) <= sizeof(local)) {
+        int needed = easyargs_format_help(local, sizeof(local), exec_alias);
+        if (needed >= 0 && (size_t) needed < sizeof(local))
+            return emit(context, local, (size_t) needed);
+    }
+
+    size_t length;
+    char* buffer = easyargs_help_text(exec_alias, &length);
+    if (!buffer)
+        return 0;
+    int ok = emit(context, buffer, length);
+    free(buffer);
+    return ok;
+}
+
+#ifndef EASYARGS_COMMON_H
+static inline int easyargs_emit_stream(void* context, const char* text, size_t length) {
+    return fwrite(text, 1, length, (FILE*) context) == length;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static inline int easyargs_emit_fd(void* context, const char* text, size_t length) {
+    int fd = *(int*) context;
+    while (length) {
+        ssize_t written = write(fd, text, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        text += written;
+        length -= (size_t) written;
+    }
+    return 1;
+}
+#endif
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+// Write the help text to a file descriptor with a single write(2). Returns 0 if failed.
+// Flush any stdio stream on the same descriptor first.
+static inline int easyargs_write_help(int fd, const char* exec_alias) {
+    return easyargs_emit_help(exec_alias, easyargs_emit_fd, &fd);
+}
+#endif
+
+// Display help string, given command used to launch program, e.g., argv[0]
+static inline void print_help(char* exec_alias) {
+    easyargs_emit_help(exec_alias, easyargs_emit_stream, stdout);
+}
+
+#define EASYARGS_COMMON_H
+
+#ifdef EASYARGS_PREFIX
+#undef REQUIRED_ARG_COUNT
+#undef OPTIONAL_ARG_COUNT
+#undef BOOLEAN_ARG_COUNT
+#undef EASYARGS_BOOLEAN_COUNT
+#undef EASYARGS_BOOLEAN_WORDS
+#undef args_t
+#undef EASYARGS_ARGS_SIZE
+#undef EASYARGS_ARGS_PADDING
+#undef easyargs_args_size_check
+#undef make_default_args
+#undef EASYARGS_OPTION_COUNT
+#undef easyargs_token_t
+#undef easyargs_load_token
+#undef easyargs_token_equals
+#undef easyargs_option_flags
+#undef easyargs_option_flag_lengths
+#undef easyargs_options
+#undef easyargs_dispatch_t
+#undef EASYARGS_HASH_SLOTS
+#undef easyargs_hash
+#undef easyargs_insert_option
+#undef easyargs_build_dispatch
+#undef easyargs_find_option
+#undef easyargs_filter_t
+#undef EASYARGS_FILTER_WORDS
+#undef easyargs_filter_hash
+#undef easyargs_filter_add
+#undef easyargs_filter_test
+#undef easyargs_build_filter
+#undef easyargs_tokens_t
+#undef easyargs_token_shape
+#undef easyargs_store_token
+#undef easyargs_count_bytes
+#undef easyargs_classify_contiguous
+#undef easyargs_classify
+#undef easyargs_bundle_t
+#undef easyargs_build_bundle
+#undef easyargs_apply_bundle
+#undef easyargs_required_labels
+#undef easyargs_error_format
+#undef easyargs_format_error
+#undef easyargs_print_errors
+#undef easyargs_context_t
+#undef easyargs_init_context
+#undef easyargs_parse
+#undef parse_args
+#undef parse_args_quiet
+#undef parse_args_with_context
+#undef easyargs_is_repeatable_option
+#undef easyargs_alloc_lists
+#undef free_args
+#undef EASYARGS_REQUIRED_COUNT
+#undef easyargs_stream_t
+#undef easyargs_store_required
+#undef easyargs_store_value
+#undef easyargs_store_boolean
+#undef easyargs_start_stream
+#undef easyargs_free_stream
+#undef easyargs_flush_stream
+#undef easyargs_stream_error
+#undef easyargs_stream_copy
+#undef easyargs_stream_token
+#undef easyargs_feed
+#undef easyargs_finish
+#undef easyargs_parse_fd
+#undef EASYARGS_HELP_WIDTH
+#undef EASYARGS_HELP_SIZE
+#undef easyargs_format_help
+#undef easyargs_help_text
+#undef easyargs_emit_help
+#undef easyargs_write_help
+#undef print_help
+#endif
+
+#endif
+
+
+// SUBCOMMANDS
+// For programs like git, where the first argument picks a subcommand with its own options.
+// Include each subcommand's schema with its own EASYARGS_PREFIX, then define SUBCOMMANDS, and
+// nothing else, and include the header once more:
+//
+//     #define SUBCOMMANDS SUBCOMMAND(build, "build", "Compile a target") SUBCOMMAND(serve, ...)
+//     #include "easyargs.h"
+//
+// Each SUBCOMMAND gives the prefix of its schema, the name typed on the command line, and a
+// description. parse_command matches the first argument against the names and hands the rest
+// to that subcommand's parser alone, so the other subcommands' options cost nothing.
+#if defined(SUBCOMMANDS) && !defined(EASYARGS_COMMANDS_H)
+#define EASYARGS_COMMANDS_H
+
+#ifndef EASYARGS_COMMON_H
+#error "Include the schema of each subcommand, with EASYARGS_PREFIX, before defining SUBCOMMANDS"
+#endif
+
+// Subcommand ids, in declaration order
+enum {
+    #define SUBCOMMAND(prefix, ...) EASYARGS_CMD_##prefix,
+    SUBCOMMANDS
+    #undef SUBCOMMAND
+
+    EASYARGS_COMMAND_COUNT
+};
+
+typedef struct {
+    int command;  // EASYARGS_CMD_* id of the chosen subcommand, or -1
+    union {
+        char easyargs_none;
+
+        #define SUBCOMMAND(prefix, ...) EASYARGS_PREFIXED(prefix, args_t) prefix;
+        SUBCOMMANDS
+        #undef SUBCOMMAND
+    } args;  // arguments of the chosen subcommand, named by its prefix
+} command_t;
+
+// Look up the subcommand named token. Returns its id, or -1.
+// Name lengths are compile-time constants, so most names are rejected without touching token.
+static inline int easyargs_find_command(const char* token) {
+    size_t len = strlen(token);
+
+    #define SUBCOMMAND(prefix, name, ...) \
+    if (len == sizeof(name) - 1 && !memcmp(token, name, sizeof(name) - 1)) \
+        return EASYARGS_CMD_##prefix;
+    SUBCOMMANDS
+    #undef SUBCOMMAND
+
+    return -1;
+}
+
+// Shared by parse_command and parse_command_quiet
+static inline int easyargs_parse_command(int argc, char* argv[], command_t* command, easyargs_errors_t* errors) {
+    command->command = -1;
+    if (!argc || !argv) {
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_NULL, -1, -1);
+        else
+            fprintf(stderr, "Internal error: null args or argv.\n");
+        return 0;
+    }
+
+    if (argc < 2) {
+        if (errors)
+            easyargs_record_error(errors, EASYARGS_ERR_MISSING_ARGS, -1, -1);
+        else
+            fprintf(stderr, "Error: no command given.\n");
+        return 0;
+    }
+
+    // The subcommand's parser sees its name as argv[0]
+    command->command = easyargs_find_command(argv[1]);
+    switch (command->command) {
+        #define SUBCOMMAND(prefix, ...) \
+        case EASYARGS_CMD_##prefix: \
+            command->args.prefix = EASYARGS_PREFIXED(prefix, make_default_args)(); \
+            if (errors) \
+                return EASYARGS_PREFIXED(prefix, parse_args_quiet)(argc - 1, argv + 1, &command->args.prefix, errors); \
+            return EASYARGS_PREFIXED(prefix, parse_args)(argc - 1, argv + 1, &command->args.prefix);
+        SUBCOMMANDS
+        #undef SUBCOMMAND
+    }
+
+    if (errors)
+        easyargs_record_error(errors, EASYARGS_ERR_UNKNOWN_COMMAND, 1, -1);
+    else
+        fprintf(stderr, "Error: unknown command '%s'.\n", argv[1]);
+    return 0;
+}
+
+// Parse the subcommand named by argv[1] and its arguments. Returns 0 if failed.
+static inline int parse_command(int argc, char* argv[], command_t* command) {
+    return easyargs_parse_command(argc, argv, command, NULL);
+}
+
+// Parse the subcommand and its arguments without printing anything. Errors are recorded in
+// errors (which may be NULL). Once a subcommand is chosen, its errors index argv + 1, so print
+// them with easyargs_print_command_errors. Returns 0 if failed.
+static inline int parse_command_quiet(int argc, char* argv[], command_t* command, easyargs_errors_t* errors) {
+    easyargs_errors_t discard = { NULL, 0, 0 };
+    return easyargs_parse_command(argc, argv, command, errors ? errors : &discard);
+}
+
+// Print the message for each stored error from parse_command_quiet, one per line
+static inline void easyargs_print_command_errors(FILE* stream, const command_t* command, const easyargs_errors_t* errors, char* argv[]) {
+    switch (command->command) {
+        #define SUBCOMMAND(prefix, ...) \
+        case EASYARGS_CMD_##prefix: \
+            EASYARGS_PREFIXED(prefix, easyargs_print_errors)(stream, errors, argv + 1); \
+            return;
+        SUBCOMMANDS
+        #undef SUBCOMMAND
+    }
+
+    int stored = errors->count < errors->capacity ? errors->count : errors->capacity;
+    for (int e = 0; e < stored; e++) {
+        const easyargs_error_t* error = &errors->errors[e];
+        if (error->code == EASYARGS_ERR_UNKNOWN_COMMAND)
+            fprintf(stream, "Error: unknown command '%s'.\n", argv[error->index]);
+        else if (error->code == EASYARGS_ERR_MISSING_ARGS)
+            fprintf(stream, "Error: no command given.\n");
+        else
+            fprintf(stream, "Internal error: null args or argv.\n");
+    }
+}
+
+// Width of the widest subcommand name, plus one
+enum {
+    EASYARGS_COMMAND_WIDTH = (int) sizeof(union {
+        char easyargs_min_width[1];
+
+        #define SUBCOMMAND(prefix, name, ...) char prefix[sizeof(name)];
+        SUBCOMMANDS
+        #undef SUBCOMMAND
+    }) - 1
+};
+
+// Display the list of subcommands, given command used to launch program, e.g., argv[0].
+// Each subcommand's own help is printed by its print_help, e.g. build_print_help.
+static inline void print_commands(char* exec_alias) {
+    printf("USAGE:\n    %s <COMMAND> [ARGUMENTS]\n\nCOMMANDS:\n", exec_alias);
+
+    #define SUBCOMMAND(prefix, name, description) \
+    printf("    " name "%*s    " description "\n", EASYARGS_COMMAND_WIDTH - (int) sizeof(name) + 1, "");
+    SUBCOMMANDS
+    #undef SUBCOMMAND
 }
 
 #endif
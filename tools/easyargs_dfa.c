@@ -0,0 +1,182 @@
+/*
+    easyargs_dfa: Generates a trie-shaped flag matcher for EasyArgs
+
+    Reads the REQUIRED_ARGS/OPTIONAL_ARGS/BOOLEAN_ARGS definitions from a schema header
+    (the same #defines you place before including easyargs.h) and prints an
+    easyargs_find_option implementation made of nested switches on the token's bytes.
+    Each byte of a token is examined at most once.
+
+    Build and run it against your schema, then point EASYARGS_DFA_DISPATCH at the output:
+
+        cc -DEASYARGS_SCHEMA='"my_args.h"' -I. tools/easyargs_dfa.c -o easyargs_dfa
+        ./easyargs_dfa > my_args_dfa.h
+
+        #include "my_args.h"
+        #define EASYARGS_DFA_DISPATCH "my_args_dfa.h"
+        #include "easyargs.h"
+
+    Regenerate whenever the schema changes. The output refuses to compile if the number
+    of options no longer matches.
+*/
+
+#ifndef EASYARGS_SCHEMA
+#error "Define EASYARGS_SCHEMA as the header holding your argument definitions"
+#endif
+
+#include EASYARGS_SCHEMA
+
+// The generator itself always uses the compare chain
+#undef EASYARGS_DFA_DISPATCH
+#undef EASYARGS_HASH_DISPATCH
+
+#include "../includes/easyargs.h"
+
+// Option names, indexed by option id
+static const char* const option_names[EASYARGS_OPTION_COUNT + 1] = {
+    #define OPTIONAL_ARG(type, name, ...) #name,
+    #define BOOLEAN_ARG(name, ...) #name,
+
+    #ifdef OPTIONAL_ARGS
+    OPTIONAL_ARGS
+    #endif
+
+    #ifdef BOOLEAN_ARGS
+    BOOLEAN_ARGS
+    #endif
+
+    #undef OPTIONAL_ARG
+    #undef BOOLEAN_ARG
+
+    NULL
+};
+
+static void print_indent(int depth) {
+    for (int i = 0; i < depth; i++)
+        printf("    ");
+}
+
+static void print_byte(unsigned char c) {
+    if (c == '\'' || c == '\\')
+        printf("'\\%c'", c);
+    else if (c >= 0x20 && c < 0x7f)
+        printf("'%c'", c);
+    else
+        printf("%u", c);
+}
+
+static void print_string(const char* text, size_t len) {
+    putchar('"');
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char) text[i];
+        if (c == '"' || c == '\\')
+            printf("\\%c", c);
+        else if (c >= 0x20 && c < 0x7f)
+            putchar(c);
+        else
+            printf("\\%03o", c);
+    }
+    putchar('"');
+}
+
+// Sort ids by flag bytes, keeping declaration order among equal flags
+static int compare_ids(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    size_t xlen = easyargs_option_flag_lengths[x];
+    size_t ylen = easyargs_option_flag_lengths[y];
+    int cmp = memcmp(easyargs_option_flags[x], easyargs_option_flags[y], xlen < ylen ? xlen : ylen);
+    if (cmp)
+        return cmp;
+    if (xlen != ylen)
+        return xlen < ylen ? -1 : 1;
+    return x - y;
+}
+
+// Emit the matcher for ids[0..count), which all share their first depth bytes.
+// Every path through the emitted code ends in a return.
+static void emit_node(const int* ids, int count, size_t depth, int indent) {
+    // Ids are sorted, so a flag ending here comes first; the earliest declared duplicate wins
+    int terminal = -1;
+    if (easyargs_option_flag_lengths[ids[0]] == depth) {
+        terminal = ids[0];
+        while (count && easyargs_option_flag_lengths[ids[0]] == depth) {
+            ids++;
+            count--;
+        }
+    }
+
+    // A single remaining flag: compare its tail directly
+    if (terminal < 0 && count == 1) {
+        size_t len = easyargs_option_flag_lengths[ids[0]];
+        print_indent(indent);
+        printf("if (len == %zu && !memcmp(token + %zu, ", len, depth);
+        print_string(easyargs_option_flags[ids[0]] + depth, len - depth);
+        printf(", %zu))\n", len - depth);
+        print_indent(indent + 1);
+        printf("return EASYARGS_NAME(EASYARGS_OPT_%s);\n", option_names[ids[0]]);
+        print_indent(indent);
+        printf("return -1;\n");
+        return;
+    }
+
+    print_indent(indent);
+    if (terminal >= 0 || depth == 0)
+        printf("if (len == %zu)\n", depth);
+    else
+        printf("if (len <= %zu)\n", depth);
+    print_indent(indent + 1);
+    if (terminal >= 0)
+        printf("return EASYARGS_NAME(EASYARGS_OPT_%s);\n", option_names[terminal]);
+    else
+        printf("return -1;\n");
+
+    if (!count) {
+        print_indent(indent);
+        printf("return -1;\n");
+        return;
+    }
+
+    print_indent(indent);
+    printf("switch ((unsigned char) token[%zu]) {\n", depth);
+    int start = 0;
+    while (start < count) {
+        unsigned char c = (unsigned char) easyargs_option_flags[ids[start]][depth];
+        int end = start + 1;
+        while (end < count && (unsigned char) easyargs_option_flags[ids[end]][depth] == c)
+            end++;
+
+        print_indent(indent);
+        printf("case ");
+        print_byte(c);
+        printf(":\n");
+        emit_node(ids + start, end - start, depth + 1, indent + 1);
+        start = end;
+    }
+    print_indent(indent);
+    printf("}\n");
+    print_indent(indent);
+    printf("return -1;\n");
+}
+
+int main(void) {
+    int ids[EASYARGS_OPTION_COUNT + 1];
+    int count = 0;
+    for (int id = 0; id < EASYARGS_OPTION_COUNT; id++)
+        ids[count++] = id;
+    qsort(ids, count, sizeof(ids[0]), compare_ids);
+
+    printf("// Generated by tools/easyargs_dfa.c from %s. Do not edit.\n\n", EASYARGS_SCHEMA);
+    printf("typedef char EASYARGS_NAME(easyargs_dfa_schema_check)[EASYARGS_OPTION_COUNT == %d ? 1 : -1];\n\n", count);
+    printf("// Look up the option whose flag is exactly the first len bytes of token. Returns its id, or -1.\n");
+    printf("static inline int easyargs_find_option(const easyargs_dispatch_t* dispatch, const char* token, size_t len) {\n");
+    printf("    (void) dispatch;\n");
+    printf("    (void) token;\n");
+    printf("    (void) len;\n\n");
+    if (count)
+        emit_node(ids, count, 0, 1);
+    else
+        printf("    return -1;\n");
+    printf("}\n");
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+    easyargs_dfa_check: Compares a generated trie matcher against the compare chain
+
+    Includes EasyArgs twice with the schema in easyargs_dfa_check_schema.h, once with the
+    compare chain and once with EASYARGS_DFA_DISPATCH, and looks up the same tokens in both:
+
+      - every string of up to 4 bytes over the bytes the flags use and a few others,
+      - each flag, with each of its bytes replaced and with each byte appended,
+
+    each at every length up to its own, as a token cut at '=' is. Generate the matcher first:
+
+        cc -DEASYARGS_SCHEMA='"easyargs_dfa_check_schema.h"' tools/easyargs_dfa.c -o easyargs_dfa
+        ./easyargs_dfa > easyargs_dfa_check_matcher.h
+        cc -O2 -I. tools/easyargs_dfa_check.c -o easyargs_dfa_check
+        ./easyargs_dfa_check
+
+    It prints the number of checks and any mismatches, and exits with 1 if there were any.
+*/
+
+#include "easyargs_dfa_check_schema.h"
+
+#define EASYARGS_PREFIX chain
+#include "../includes/easyargs.h"
+#undef EASYARGS_PREFIX
+
+#define EASYARGS_PREFIX dfa
+#define EASYARGS_DFA_DISPATCH "easyargs_dfa_check_matcher.h"
+#include "../includes/easyargs.h"
+#undef EASYARGS_DFA_DISPATCH
+#undef EASYARGS_PREFIX
+
+enum { MAX_TOKEN = 32 };
+
+static unsigned long long checks = 0;
+static unsigned long long mismatches = 0;
+
+// Look up text at every length up to its own in both matchers
+static void check(const char* text, size_t size) {
+    chain_easyargs_dispatch_t chain_dispatch;
+    dfa_easyargs_dispatch_t dfa_dispatch;
+    chain_easyargs_build_dispatch(&chain_dispatch);
+    dfa_easyargs_build_dispatch(&dfa_dispatch);
+
+    for (size_t len = 0; len <= size; len++) {
+        int want = chain_easyargs_find_option(&chain_dispatch, text, len);
+        int got = dfa_easyargs_find_option(&dfa_dispatch, text, len);
+        checks++;
+        if (got != want && mismatches++ < 20) {
+            printf("MISMATCH \"");
+            for (size_t i = 0; i < len; i++)
+                printf((unsigned char) text[i] >= 0x20 && (unsigned char) text[i] < 0x7f ? "%c" : "\\x%02x", (unsigned char) text[i]);
+            printf("\": %d, expected %d\n", got, want);
+        }
+    }
+}
+
+// Every byte in a flag, and a few that are in none
+static size_t collect_alphabet(unsigned char* alphabet) {
+    unsigned char seen[256] = { 0 };
+    seen['x'] = seen['='] = seen[0x80] = seen[0xfe] = 1;
+    for (int id = 0; id < chain_EASYARGS_OPTION_COUNT; id++)
+        for (size_t i = 0; i < chain_easyargs_option_flag_lengths[id]; i++)
+            seen[(unsigned char) chain_easyargs_option_flags[id][i]] = 1;
+
+    size_t size = 0;
+    for (int c = 1; c < 256; c++)
+        if (seen[c])
+            alphabet[size++] = (unsigned char) c;
+    return size;
+}
+
+// Every string of up to max_length bytes over alphabet
+static void check_exhaustive(const unsigned char* alphabet, size_t size, int max_length) {
+    int digits[8] = { 0 };
+    char text[8];
+    for (;;) {
+        for (int i = 0; i < max_length; i++)
+            text[i] = (char) alphabet[digits[i]];
+        text[max_length] = '\0';
+        check(text, (size_t) max_length);
+
+        int i = 0;
+        while (i < max_length && ++digits[i] == (int) size)
+            digits[i++] = 0;
+        if (i == max_length)
+            break;
+    }
+}
+
+// Each flag with one byte replaced or appended
+static void check_flags(const unsigned char* alphabet, size_t size) {
+    char text[MAX_TOKEN + 2];
+    for (int id = 0; id < chain_EASYARGS_OPTION_COUNT; id++) {
+        size_t len = chain_easyargs_option_flag_lengths[id];
+        if (len > MAX_TOKEN)
+            continue;
+        for (size_t at = 0; at <= len; at++) {
+            for (size_t a = 0; a < size; a++) {
+                memcpy(text, chain_easyargs_option_flags[id], len);
+                text[at] = (char) alphabet[a];
+                size_t text_len = at == len ? len + 1 : len;
+                text[text_len] = '\0';
+                check(text, text_len);
+            }
+        }
+    }
+}
+
+int main(void) {
+    unsigned char alphabet[256];
+    size_t size = collect_alphabet(alphabet);
+    check_exhaustive(alphabet, size, 4);
+    check_flags(alphabet, size);
+
+    printf("%llu checks, %llu mismatches\n", checks, mismatches);
+    return mismatches != 0;
+}
@@ -0,0 +1,19 @@
+// Schema for easyargs_dfa_check: flags sharing prefixes, flags that are prefixes of others, a
+// repeated flag, and flags that branch on bytes outside ASCII
+#define OPTIONAL_ARGS \
+    OPTIONAL_INT_ARG(count, 1, "-n", "n", "Count") \
+    OPTIONAL_INT_ARG(number, 1, "--number", "n", "Number") \
+    OPTIONAL_STRING_ARG(name, "x", "--name", "name", "Name") \
+    OPTIONAL_STRING_ARG(size, "x", "--größe", "size", "Size")
+
+#define BOOLEAN_ARGS \
+    BOOLEAN_ARG(verbose, "-v", "Verbose") \
+    BOOLEAN_ARG(version, "--version", "Version") \
+    BOOLEAN_ARG(verbatim, "--verbatim", "Verbatim") \
+    BOOLEAN_ARG(nested, "--n", "Prefix of other flags") \
+    BOOLEAN_ARG(a_umlaut, "--ä", "Non-ASCII") \
+    BOOLEAN_ARG(o_umlaut, "--ö", "Non-ASCII") \
+    BOOLEAN_ARG(o_umlaut_long, "--öl", "Non-ASCII, longer") \
+    BOOLEAN_ARG(high, "--\xff", "Highest byte") \
+    BOOLEAN_ARG(quiet, "-q", "Quiet") \
+    BOOLEAN_ARG(silent, "-q", "Same flag, declared later")
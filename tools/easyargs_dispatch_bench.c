@@ -0,0 +1,113 @@
+/*
+    easyargs_dispatch_bench: Measures flag lookup cost as the number of options grows
+
+    Includes EasyArgs three times, with schemas of 3, 300 and 3000 boolean options, and parses
+    a command line of tokens cycling through each schema's flags. Each schema is timed twice:
+    with parse_args, which builds its lookup structures on every call, and with one context
+    reused for every parse, which measures the lookup alone. Compile with the dispatch to
+    measure:
+
+        cc -O2 tools/easyargs_dispatch_bench.c -o easyargs_dispatch_bench
+        cc -O2 -DEASYARGS_HASH_DISPATCH tools/easyargs_dispatch_bench.c -o easyargs_dispatch_bench
+        ./easyargs_dispatch_bench 1000 2000
+
+    The arguments are the tokens per command line and the parses per measurement.
+*/
+
+#define _POSIX_C_SOURCE 199309L  // for clock_gettime
+
+#include <time.h>
+
+// Ten, a hundred or a thousand flags named after a prefix, e.g. --a0 to --a9
+#define BENCH_FLAG(name) BOOLEAN_ARG(name, "--" #name, "Benchmark flag")
+#define BENCH_FLAGS_10(p) \
+    BENCH_FLAG(p##0) BENCH_FLAG(p##1) BENCH_FLAG(p##2) BENCH_FLAG(p##3) BENCH_FLAG(p##4) \
+    BENCH_FLAG(p##5) BENCH_FLAG(p##6) BENCH_FLAG(p##7) BENCH_FLAG(p##8) BENCH_FLAG(p##9)
+#define BENCH_FLAGS_100(p) \
+    BENCH_FLAGS_10(p##0) BENCH_FLAGS_10(p##1) BENCH_FLAGS_10(p##2) BENCH_FLAGS_10(p##3) BENCH_FLAGS_10(p##4) \
+    BENCH_FLAGS_10(p##5) BENCH_FLAGS_10(p##6) BENCH_FLAGS_10(p##7) BENCH_FLAGS_10(p##8) BENCH_FLAGS_10(p##9)
+#define BENCH_FLAGS_1000(p) \
+    BENCH_FLAGS_100(p##0) BENCH_FLAGS_100(p##1) BENCH_FLAGS_100(p##2) BENCH_FLAGS_100(p##3) BENCH_FLAGS_100(p##4) \
+    BENCH_FLAGS_100(p##5) BENCH_FLAGS_100(p##6) BENCH_FLAGS_100(p##7) BENCH_FLAGS_100(p##8) BENCH_FLAGS_100(p##9)
+
+#define BOOLEAN_ARGS BENCH_FLAG(a) BENCH_FLAG(b) BENCH_FLAG(c)
+#define EASYARGS_PREFIX small
+#include "../includes/easyargs.h"
+#undef BOOLEAN_ARGS
+#undef EASYARGS_PREFIX
+
+#define BOOLEAN_ARGS BENCH_FLAGS_100(a) BENCH_FLAGS_100(b) BENCH_FLAGS_100(c)
+#define EASYARGS_PREFIX medium
+#include "../includes/easyargs.h"
+#undef BOOLEAN_ARGS
+#undef EASYARGS_PREFIX
+
+#define BOOLEAN_ARGS BENCH_FLAGS_1000(a) BENCH_FLAGS_1000(b) BENCH_FLAGS_1000(c)
+#define EASYARGS_PREFIX large
+#include "../includes/easyargs.h"
+#undef BOOLEAN_ARGS
+#undef EASYARGS_PREFIX
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+// Time parses of a command line cycling through the flags, with and without a reused context.
+// Prints nanoseconds per token.
+#define BENCH_SCHEMA(prefix) do { \
+    argv[0] = "bench"; \
+    for (int i = 1; i < argc; i++) \
+        argv[i] = (char*) prefix##_easyargs_option_flags[(i - 1) % prefix##_EASYARGS_OPTION_COUNT]; \
+    \
+    int ok = 1; \
+    double start = now(); \
+    for (int run = 0; run < runs; run++) { \
+        prefix##_args_t args = prefix##_make_default_args(); \
+        ok &= prefix##_parse_args(argc, argv, &args); \
+    } \
+    double fresh = now() - start; \
+    \
+    prefix##_easyargs_context_t context; \
+    prefix##_easyargs_init_context(&context, NULL); \
+    start = now(); \
+    for (int run = 0; run < runs; run++) { \
+        prefix##_args_t args = prefix##_make_default_args(); \
+        ok &= prefix##_parse_args_with_context(&context, argc, argv, &args); \
+    } \
+    double reused = now() - start; \
+    \
+    if (!ok) \
+        return 1; \
+    double tokens = (double) runs * (argc - 1); \
+    printf("%8d %14.1f %14.1f\n", (int) prefix##_EASYARGS_OPTION_COUNT, fresh / tokens * 1e9, reused / tokens * 1e9); \
+} while (0)
+
+int main(int argc_, char* argv_[]) {
+    int tokens = argc_ > 1 ? atoi(argv_[1]) : 1000;
+    int runs = argc_ > 2 ? atoi(argv_[2]) : 2000;
+    if (tokens < 1 || runs < 1) {
+        fprintf(stderr, "Usage: %s [tokens] [parses]\n", argv_[0]);
+        return 1;
+    }
+
+    int argc = tokens + 1;
+    char** argv = (char**) malloc((size_t) (argc + 1) * sizeof(char*));
+    if (!argv)
+        return 1;
+    argv[argc] = NULL;
+
+    #if defined(EASYARGS_HASH_DISPATCH)
+    printf("dispatch: hash table\n");
+    #else
+    printf("dispatch: compare chain\n");
+    #endif
+    printf("%8s %14s %14s\n", "options", "ns/token", "reused ns/tok");
+    BENCH_SCHEMA(small);
+    BENCH_SCHEMA(medium);
+    BENCH_SCHEMA(large);
+
+    free(argv);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+    easyargs_float_bench: Measures float and double parsing on typical hyperparameter values
+
+    Parses a fixed corpus of the values sweep launchers pass, such as learning rates, decay
+    factors and batch sizes, with easyargs_scan_double/easyargs_scan_float and with
+    strtod/strtof, taking the best of several runs, and prints the time per value.
+
+        cc -O2 tools/easyargs_float_bench.c -o easyargs_float_bench
+        ./easyargs_float_bench 200000
+
+    The argument is the number of passes over the corpus per run.
+*/
+
+#define _POSIX_C_SOURCE 199309L  // for clock_gettime
+
+#include <time.h>
+
+#include "../includes/easyargs.h"
+
+static const char* const corpus[] = {
+    "0.001", "3e-4", "0.95", "1024", "0.9", "0.999", "1e-8", "5e-5", "0.1", "256",
+    "0.0003", "2.5e-4", "0.5", "64", "1e-3", "0.98", "12.5", "-0.25", "7e-6", "0.0625"
+};
+
+enum { CORPUS_SIZE = sizeof(corpus) / sizeof(corpus[0]) };
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static easyargs_status_t strtod_scan(const char* text, double* value) {
+    char* end;
+    *value = strtod(text, &end);
+    return *end ? EASYARGS_ERR_SYNTAX : EASYARGS_OK;
+}
+
+static easyargs_status_t strtof_scan(const char* text, float* value) {
+    char* end;
+    *value = strtof(text, &end);
+    return *end ? EASYARGS_ERR_SYNTAX : EASYARGS_OK;
+}
+
+// Best time per value over five runs of passes over the corpus, in nanoseconds
+#define BENCH_SCANNER(valtype, scanner, passes) do { \
+    volatile valtype sink = 0; \
+    double best = 0; \
+    for (int run = 0; run < 5; run++) { \
+        double start = now(); \
+        for (long pass = 0; pass < (passes); pass++) { \
+            for (int i = 0; i < CORPUS_SIZE; i++) { \
+                valtype value = 0; \
+                if (scanner(corpus[i], &value) != EASYARGS_OK) \
+                    return 1; \
+                sink += value; \
+            } \
+        } \
+        double elapsed = now() - start; \
+        if (!run || elapsed < best) \
+            best = elapsed; \
+    } \
+    (void) sink; \
+    printf("%-22s %8.1f ns\n", #scanner, best / ((double) (passes) * CORPUS_SIZE) * 1e9); \
+} while (0)
+
+int main(int argc, char* argv[]) {
+    long passes = argc > 1 ? atol(argv[1]) : 200000;
+    if (passes < 1) {
+        fprintf(stderr, "Usage: %s [passes]\n", argv[0]);
+        return 1;
+    }
+
+    BENCH_SCANNER(double, easyargs_scan_double, passes);
+    BENCH_SCANNER(double, strtod_scan, passes);
+    BENCH_SCANNER(float, easyargs_scan_float, passes);
+    BENCH_SCANNER(float, strtof_scan, passes);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+    easyargs_float_check: Compares the float and double scanners against strtof/strtod
+
+    The scanners take a fast path for plain decimal input and must give bit-identical results
+    to strtof/strtod, with the same accept/reject and range decisions. This runs both scanners
+    and a reference built on strtof/strtod (as the parsers used to be) over:
+
+      - every string of up to 7 characters over "0159.e-+",
+      - decimals near the limits of the fast path: 2^24 and 2^53, and powers of ten up to 22,
+      - random decimals of up to 19 significant digits with exponents in [-30, 30].
+
+    It prints the number of checks and any mismatches, and exits with 1 if there were any.
+    Run it in the C locale, which is the default.
+
+        cc -O2 tools/easyargs_float_check.c -o easyargs_float_check
+        ./easyargs_float_check
+*/
+
+#include "../includes/easyargs.h"
+
+// Reference scanners: the checks of the former parsers, around strtof/strtod
+#define DEFINE_FLOAT_REFERENCE(funcname, valtype, strtox) \
+static easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
+    text = easyargs_skip_leading(text); \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    char* end; \
+    errno = 0; \
+    valtype val = strtox(text, &end); \
+    if (errno == ERANGE) return EASYARGS_ERR_RANGE; \
+    if (*end != '\0') return EASYARGS_ERR_SYNTAX; \
+    *value = val; \
+    return EASYARGS_OK; \
+}
+
+DEFINE_FLOAT_REFERENCE(reference_float, float, strtof)
+DEFINE_FLOAT_REFERENCE(reference_double, double, strtod)
+
+static unsigned long long checks = 0;
+static unsigned long long mismatches = 0;
+
+// Compare one scanner with its reference on text, bit for bit
+#define CHECK_TYPE(valtype, scanner, reference) do { \
+    valtype got = 0, want = 0; \
+    easyargs_status_t got_status = scanner(text, &got); \
+    easyargs_status_t want_status = reference(text, &want); \
+    checks++; \
+    if (got_status != want_status || (want_status == EASYARGS_OK && memcmp(&got, &want, sizeof(got)))) { \
+        if (mismatches++ < 20) \
+            printf("MISMATCH %s(\"%s\"): status %d = %.17g, expected %d = %.17g\n", #scanner, text, \
+                   (int) got_status, (double) got, (int) want_status, (double) want); \
+    } \
+} while (0)
+
+static void check(const char* text) {
+    CHECK_TYPE(float, easyargs_scan_float, reference_float);
+    CHECK_TYPE(double, easyargs_scan_double, reference_double);
+}
+
+// Every string of up to max_length characters over alphabet
+static void check_exhaustive(const char* alphabet, int max_length) {
+    size_t size = strlen(alphabet);
+    int digits[8] = { 0 };
+    char text[8];
+    for (int length = 0; length <= max_length; length++) {
+        for (int i = 0; i < length; i++)
+            digits[i] = 0;
+        for (;;) {
+            for (int i = 0; i < length; i++)
+                text[i] = alphabet[digits[i]];
+            text[length] = '\0';
+            check(text);
+
+            int i = 0;
+            while (i < length && ++digits[i] == (int) size)
+                digits[i++] = 0;
+            if (i == length)
+                break;
+        }
+    }
+}
+
+// Mantissas around the largest exact ones, and each power of ten the fast path uses
+static void check_boundaries(void) {
+    static const unsigned long long mantissas[] = {
+        (1ULL << 24) - 1, 1ULL << 24, (1ULL << 24) + 1, (1ULL << 24) + 3,
+        (1ULL << 53) - 1, 1ULL << 53, (1ULL << 53) + 1, (1ULL << 53) + 3,
+        9999999999999999999ULL, 1, 3, 7, 123456789
+    };
+    char text[64];
+    for (size_t m = 0; m < sizeof(mantissas) / sizeof(mantissas[0]); m++) {
+        for (int exponent = -25; exponent <= 25; exponent++) {
+            snprintf(text, sizeof(text), "%llue%d", mantissas[m], exponent);
+            check(text);
+            snprintf(text, sizeof(text), "-%llue%d", mantissas[m], exponent);
+            check(text);
+        }
+    }
+
+    static const char* const special[] = {
+        "0.1", "0.2", "0.3", "1e23", "8.5e-1", "3e-4", "1e-310", "4.9e-324", "2e-324", "1.7976931348623157e308",
+        "1.8e308", "3.4028235e38", "3.5e38", "1.4e-45", "1e-46", "inf", "-inf", "nan", "0x1p-2", "1e",
+        "1e+", ".", "-.", ".5", "5.", "00000000000000000000000000001", "0.000000000000000000000000000001",
+        "1.00000000000000000001", "9007199254740993", "16777217", " 2.5", "2.5 ", "+-1", "1,5"
+    };
+    for (size_t i = 0; i < sizeof(special) / sizeof(special[0]); i++)
+        check(special[i]);
+}
+
+// Random decimals with fixed seed: up to 19 significant digits, a point, and an exponent
+static void check_random(unsigned long count) {
+    uint64_t state = 0x2545f4914f6cdd1du;
+    char text[48];
+    for (unsigned long n = 0; n < count; n++) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        uint64_t bits = state >> 11;
+        int digits = 1 + (int) (bits % 19);
+        bits /= 19;
+        int point = (int) (bits % (unsigned) (digits + 1));
+        bits /= (unsigned) (digits + 1);
+        int exponent = (int) (bits % 61) - 30;
+        bits /= 61;
+
+        int length = 0;
+        if (bits & 1)
+            text[length++] = '-';
+        for (int i = 0; i < digits; i++) {
+            if (i == point)
+                text[length++] = '.';
+            state = state * 6364136223846793005u + 1442695040888963407u;
+            text[length++] = (char) ('0' + (state >> 33) % 10);
+        }
+        if (bits & 2)
+            snprintf(text + length, sizeof(text) - (size_t) length, "e%d", exponent);
+        else
+            text[length] = '\0';
+        check(text);
+    }
+}
+
+int main(void) {
+    check(NULL);
+    check_exhaustive("0159.e-+", 7);
+    check_boundaries();
+    check_random(3000000);
+
+    printf("%llu checks, %llu mismatches\n", checks, mismatches);
+    return mismatches != 0;
+}
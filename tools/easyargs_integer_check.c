@@ -0,0 +1,187 @@
+/*
+    easyargs_integer_check: Compares the integer scanners against strtoull/strtoll
+
+    The integer scanners parse without libc, but must accept and reject exactly what the
+    strtoull/strtoll based parsers did, with the same value. This runs every integer scanner
+    and a reference built on strtoull/strtoll (as the parsers used to be) over:
+
+      - every string of up to 5 characters over "0178x9aAfFgX-+ .",
+      - values around each power of two up to 2^64, in decimal, hex and octal, with signs and
+        leading zeros, including the first values past 2^64,
+      - random digit strings of up to 24 characters, some with a junk character inserted.
+
+    It prints the number of checks and any mismatches, and exits with 1 if there were any.
+
+        cc -O2 tools/easyargs_integer_check.c -o easyargs_integer_check
+        ./easyargs_integer_check
+*/
+
+#include "../includes/easyargs.h"
+
+// Reference scanners: the checks of the former parsers, around strtoull/strtoll
+#define DEFINE_UNSIGNED_REFERENCE(funcname, valtype, maxval) \
+static easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
+    text = easyargs_skip_leading(text); \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    if (text[0] == '-') return EASYARGS_ERR_NEGATIVE; \
+    char* end; \
+    errno = 0; \
+    unsigned long long val = strtoull(text, &end, 0); \
+    if (*end != '\0') return EASYARGS_ERR_SYNTAX; \
+    if (errno == ERANGE || val > (unsigned long long)(maxval)) return EASYARGS_ERR_RANGE; \
+    *value = (valtype) val; \
+    return EASYARGS_OK; \
+}
+
+#define DEFINE_SIGNED_REFERENCE(funcname, valtype, minval, maxval) \
+static easyargs_status_t funcname(const char* text, valtype* value) { \
+    if (!text) return EASYARGS_ERR_NULL; \
+    text = easyargs_skip_leading(text); \
+    if (text[0] == '\0') return EASYARGS_ERR_EMPTY; \
+    char* end; \
+    errno = 0; \
+    long long val = strtoll(text, &end, 0); \
+    if (*end != '\0') return EASYARGS_ERR_SYNTAX; \
+    if (errno == ERANGE || val < (long long)(minval) || val > (long long)(maxval)) return EASYARGS_ERR_RANGE; \
+    *value = (valtype) val; \
+    return EASYARGS_OK; \
+}
+
+DEFINE_UNSIGNED_REFERENCE(reference_uint, unsigned int, UINT_MAX)
+DEFINE_UNSIGNED_REFERENCE(reference_ulong, unsigned long, ULONG_MAX)
+DEFINE_UNSIGNED_REFERENCE(reference_ullong, unsigned long long, ULLONG_MAX)
+DEFINE_UNSIGNED_REFERENCE(reference_size_t, size_t, SIZE_MAX)
+DEFINE_SIGNED_REFERENCE(reference_int, int, INT_MIN, INT_MAX)
+DEFINE_SIGNED_REFERENCE(reference_long, long, LONG_MIN, LONG_MAX)
+DEFINE_SIGNED_REFERENCE(reference_llong, long long, LLONG_MIN, LLONG_MAX)
+
+static unsigned long long checks = 0;
+static unsigned long long mismatches = 0;
+
+// Compare one scanner with its reference on text
+#define CHECK_TYPE(valtype, scanner, reference) do { \
+    valtype got = 0, want = 0; \
+    easyargs_status_t got_status = scanner(text, &got); \
+    easyargs_status_t want_status = reference(text, &want); \
+    checks++; \
+    if (got_status != want_status || (want_status == EASYARGS_OK && got != want)) { \
+        if (mismatches++ < 20) \
+            printf("MISMATCH %s(\"%s\"): status %d, expected %d\n", #scanner, text, (int) got_status, (int) want_status); \
+    } \
+} while (0)
+
+static void check(const char* text) {
+    CHECK_TYPE(unsigned int, easyargs_scan_uint, reference_uint);
+    CHECK_TYPE(unsigned long, easyargs_scan_ulong, reference_ulong);
+    CHECK_TYPE(unsigned long long, easyargs_scan_ullong, reference_ullong);
+    CHECK_TYPE(size_t, easyargs_scan_size_t, reference_size_t);
+    CHECK_TYPE(int, easyargs_scan_int, reference_int);
+    CHECK_TYPE(long, easyargs_scan_long, reference_long);
+    CHECK_TYPE(long long, easyargs_scan_llong, reference_llong);
+}
+
+// Every string of up to max_length characters over alphabet
+static void check_exhaustive(const char* alphabet, int max_length) {
+    size_t size = strlen(alphabet);
+    int digits[8] = { 0 };
+    char text[8];
+    for (int length = 0; length <= max_length; length++) {
+        for (int i = 0; i < length; i++)
+            digits[i] = 0;
+        for (;;) {
+            for (int i = 0; i < length; i++)
+                text[i] = alphabet[digits[i]];
+            text[length] = '\0';
+            check(text);
+
+            int i = 0;
+            while (i < length && ++digits[i] == (int) size)
+                digits[i++] = 0;
+            if (i == length)
+                break;
+        }
+    }
+}
+
+// value in each base, with each sign and with leading zeros. The decimal form is also
+// checked with a digit appended, which reaches past 2^64.
+static void check_value(unsigned long long value) {
+    static const char* const signs[] = { "", "+", "-", " ", " -" };
+    char text[96];
+    for (size_t s = 0; s < sizeof(signs) / sizeof(signs[0]); s++) {
+        snprintf(text, sizeof(text), "%s%llu", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s%llu0", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s%llu9", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s0000%llu", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s0x%llx", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s0X%llX0", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s0%llo", signs[s], value);
+        check(text);
+        snprintf(text, sizeof(text), "%s0%llo7", signs[s], value);
+        check(text);
+    }
+}
+
+static void check_boundaries(void) {
+    for (int bit = 0; bit <= 64; bit++) {
+        unsigned long long power = bit == 64 ? 0 : 1ULL << bit;
+        for (unsigned long long delta = 0; delta < 4; delta++) {
+            check_value(power + delta);
+            check_value(power - delta - 1);
+        }
+    }
+
+    // The first values past 2^64, which need more digits than fit
+    static const char* const past[] = {
+        "18446744073709551615", "18446744073709551616", "18446744073709551617", "18446744073709551625",
+        "18446744073709551715", "18446744073709552615", "99999999999999999999", "100000000000000000000",
+        "0xffffffffffffffff", "0x10000000000000000", "0x0000ffffffffffffffff", "01777777777777777777777",
+        "02000000000000000000000", "9223372036854775807", "9223372036854775808", "-9223372036854775808",
+        "-9223372036854775809", "-18446744073709551615", "-18446744073709551616", "-0x8000000000000000",
+        "-0x8000000000000001", "000000000000000000000000000000", "-0", "+0", "0x", "0x0", "08", "0b1"
+    };
+    for (size_t i = 0; i < sizeof(past) / sizeof(past[0]); i++)
+        check(past[i]);
+}
+
+// Random digit strings, with fixed seed, some with a junk character inserted
+static void check_random(unsigned long count) {
+    static const char junk[] = "x.-+ eE_/:a";
+    uint64_t state = 0x9e3779b97f4a7c15u;
+    char text[32];
+    for (unsigned long n = 0; n < count; n++) {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        uint64_t bits = state >> 16;
+        int length = 1 + (int) (bits % 24);
+        bits /= 24;
+        int start = 0;
+        if (bits & 1)
+            text[start++] = bits & 2 ? '-' : '+';
+        bits >>= 2;
+        for (int i = start; i < length + start; i++) {
+            state = state * 6364136223846793005u + 1442695040888963407u;
+            text[i] = (char) ('0' + (state >> 33) % 10);
+        }
+        text[length + start] = '\0';
+        if (bits % 4 == 0)
+            text[(bits >> 2) % (unsigned) (length + start)] = junk[(bits >> 8) % (sizeof(junk) - 1)];
+        check(text);
+    }
+}
+
+int main(void) {
+    check(NULL);
+    check_exhaustive("0178x9aAfFgX-+ .", 5);
+    check_boundaries();
+    check_random(2000000);
+
+    printf("%llu checks, %llu mismatches\n", checks, mismatches);
+    return mismatches != 0;
+}
@@ -0,0 +1,97 @@
+/*
+    easyargs_split_bench: Measures how response file splitting scales with threads
+
+    Expands one response file with 1, 2, 4, ... up to the given number of threads, taking the
+    best of several runs for each, and prints the time and speedup over one thread. Pass -g
+    to write a synthetic manifest of that many MiB to the path first.
+
+        cc -O2 -pthread tools/easyargs_split_bench.c -o easyargs_split_bench
+        ./easyargs_split_bench manifest.rsp -g 4096 -t 64
+
+    The file is mapped afresh for every run, so the first run also pays for reading it from
+    disk. Use a file that fits in the page cache.
+*/
+
+#define _POSIX_C_SOURCE 199309L  // for clock_gettime
+
+#include <time.h>
+
+#define REQUIRED_ARGS \
+    REQUIRED_STRING_ARG(path, "path", "Response file to split")
+
+#define OPTIONAL_ARGS \
+    OPTIONAL_INT_ARG(max_threads, 64, "-t", "threads", "Most threads to try") \
+    OPTIONAL_INT_ARG(runs, 3, "-r", "runs", "Runs per thread count") \
+    OPTIONAL_INT_ARG(generate, 0, "-g", "MiB", "Write a manifest of this size first")
+
+#define EASYARGS_THREADS
+#include "../includes/easyargs.h"
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+// Shard paths of varying length, one per line
+static int generate(const char* path, long mebibytes) {
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return 0;
+    long long target = (long long) mebibytes << 20;
+    long long written = 0;
+    for (unsigned long i = 0; written < target; i++) {
+        int length = fprintf(file, "/data/shards/%05lu/part-%08lu.bin\n", i % 4096, i);
+        if (length < 0)
+            break;
+        written += length;
+    }
+    return !fclose(file) && written >= target;
+}
+
+int main(int argc, char* argv[]) {
+    args_t args = make_default_args();
+    if (!parse_args(argc, argv, &args))
+        return 1;
+
+    if (args.generate > 0 && !generate(args.path, args.generate)) {
+        fprintf(stderr, "Cannot write %s\n", args.path);
+        return 1;
+    }
+
+    // Response files are named with a leading @
+    size_t length = strlen(args.path);
+    char* name = (char*) malloc(length + 2);
+    if (!name)
+        return 1;
+    name[0] = '@';
+    memcpy(name + 1, args.path, length + 1);
+    char* expand_argv[] = { argv[0], name, NULL };
+
+    printf("%8s %12s %12s %8s\n", "threads", "arguments", "seconds", "speedup");
+    double single = 0;
+    for (int threads = 1; threads <= args.max_threads; threads *= 2) {
+        double best = 0;
+        int count = 0;
+        for (int run = 0; run < args.runs; run++) {
+            easyargs_response_t files;
+            double start = now();
+            int ok = easyargs_expand_response_files_parallel(2, expand_argv, &files, threads);
+            double elapsed = now() - start;
+            count = files.argc - 1;
+            easyargs_free_response_files(&files);
+            if (!ok) {
+                fprintf(stderr, "Cannot read %s\n", args.path);
+                return 1;
+            }
+            if (!run || elapsed < best)
+                best = elapsed;
+        }
+        if (threads == 1)
+            single = best;
+        printf("%8d %12d %12.4f %7.2fx\n", threads, count, best, single / best);
+    }
+
+    free(name);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+    easyargs_split_check: Checks that splitting a response file across threads changes nothing
+
+    Writes response files of fixed-length lines, with a quoted or escaped argument on the line
+    where each thread's chunk starts, and expands each with one thread and with 2 to 8. Every
+    thread count must give the same arguments as one thread, which uses the full tokenizer.
+    Files with quotes or backslashes fall back to it too, wherever in a chunk they are.
+
+    It prints the number of checks and any mismatches, and exits with 1 if there were any.
+    The files are written to the given path, or easyargs_split_check.rsp, and removed after.
+
+        cc -O2 -pthread tools/easyargs_split_check.c -o easyargs_split_check
+        ./easyargs_split_check
+*/
+
+#define EASYARGS_THREADS
+#include "../includes/easyargs.h"
+
+enum {
+    LINE_LENGTH = 32,
+    MAX_THREADS = 8,
+    LINE_COUNT = ((MAX_THREADS + 1) << 20) / LINE_LENGTH  // enough for MAX_THREADS chunks
+};
+
+// Lines of LINE_LENGTH bytes, each one argument, or two for the escape if split naively
+static const char* const special_formats[] = {
+    "\"/data/quoted %016lu\"\n",
+    "'/data/quoted %016lu'\n",
+    "\\ /data/escaped%016lu\n"
+};
+
+static unsigned long long checks = 0;
+static unsigned long long mismatches = 0;
+
+// Format line number into its LINE_LENGTH bytes of text, without a terminator
+static void put_line(char* text, const char* format, unsigned long line) {
+    char buffer[LINE_LENGTH + 1];
+    snprintf(buffer, sizeof(buffer), format, line);
+    memcpy(text + line * LINE_LENGTH, buffer, LINE_LENGTH);
+}
+
+// The file as one thread count cuts it, with a special line starting each chunk
+static int write_file(const char* path, const char* special, int threads) {
+    size_t size = (size_t) LINE_COUNT * LINE_LENGTH;
+    char* text = (char*) malloc(size);
+    if (!text)
+        return 0;
+    for (unsigned long line = 0; line < LINE_COUNT; line++)
+        put_line(text, "/data/part-%020lu\n", line);
+
+    // Chunk i > 0 starts on the line after the one holding byte size / threads * i
+    for (int i = 0; i < threads; i++) {
+        size_t line = i ? size / (size_t) threads * (size_t) i / LINE_LENGTH + 1 : 0;
+        put_line(text, special, (unsigned long) line);
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        free(text);
+        return 0;
+    }
+    int ok = fwrite(text, 1, size, file) == size;
+    free(text);
+    return !fclose(file) && ok;
+}
+
+static int check(char* name, const char* special, int threads) {
+    char* expand_argv[] = { "check", name, NULL };
+    easyargs_response_t expected, got;
+    int ok = easyargs_expand_response_files_parallel(2, expand_argv, &expected, 1);
+    ok &= easyargs_expand_response_files_parallel(2, expand_argv, &got, threads);
+
+    checks++;
+    int same = ok && got.argc == expected.argc && got.argc == LINE_COUNT + 1;
+    for (int i = 0; same && i < got.argc; i++)
+        same = !strcmp(got.argv[i], expected.argv[i]);
+    if (!same && mismatches++ < 20)
+        printf("MISMATCH %.2s... at chunk starts, %d threads: %d arguments, expected %d\n",
+               special, threads, got.argc - 1, expected.argc - 1);
+
+    easyargs_free_response_files(&expected);
+    easyargs_free_response_files(&got);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "easyargs_split_check.rsp";
+
+    // Response files are named with a leading @
+    size_t length = strlen(path);
+    char* name = (char*) malloc(length + 2);
+    if (!name)
+        return 1;
+    name[0] = '@';
+    memcpy(name + 1, path, length + 1);
+
+    for (size_t s = 0; s < sizeof(special_formats) / sizeof(special_formats[0]); s++) {
+        for (int threads = 2; threads <= MAX_THREADS; threads++) {
+            if (!write_file(path, special_formats[s], threads) || !check(name, special_formats[s], threads)) {
+                fprintf(stderr, "Cannot write or read %s\n", path);
+                remove(path);
+                return 1;
+            }
+        }
+    }
+    remove(path);
+    free(name);
+
+    printf("%llu checks, %llu mismatches\n", checks, mismatches);
+    return mismatches != 0;
+}